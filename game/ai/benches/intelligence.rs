@@ -0,0 +1,135 @@
+use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion};
+
+use ai::{
+    AiBox, Blackboard, Consideration, ConsiderationParameter, Context, Curve, DecisionWeightType,
+    Dse, Input, Intelligence,
+};
+
+#[derive(Eq, PartialEq, Clone, Debug)]
+enum BenchAction {
+    Nop,
+    Eat,
+}
+
+impl Default for BenchAction {
+    fn default() -> Self {
+        BenchAction::Nop
+    }
+}
+
+#[derive(Clone, Hash, Eq, PartialEq)]
+enum BenchInput {
+    MyHunger,
+    /// out of 100
+    Constant(u32),
+}
+
+impl Input<BenchContext> for BenchInput {
+    fn get(&self, blackboard: &mut BenchBlackboard) -> f32 {
+        match self {
+            BenchInput::MyHunger => blackboard.my_hunger,
+            BenchInput::Constant(c) => (*c as f32) / 100.0,
+        }
+    }
+}
+
+struct BenchBlackboard {
+    my_hunger: f32,
+}
+
+impl Blackboard for BenchBlackboard {
+    #[cfg(feature = "logging")]
+    fn entity(&self) -> String {
+        String::new()
+    }
+}
+
+#[derive(Debug)]
+struct BenchContext;
+
+impl Context for BenchContext {
+    type Blackboard = BenchBlackboard;
+    type Input = BenchInput;
+    type Action = BenchAction;
+    type AdditionalDseId = u32;
+}
+
+struct MyHungerConsideration;
+
+impl Consideration<BenchContext> for MyHungerConsideration {
+    fn curve(&self) -> Curve {
+        Curve::Linear(1.0, 0.0)
+    }
+
+    fn input(&self) -> BenchInput {
+        BenchInput::MyHunger
+    }
+
+    fn parameter(&self) -> ConsiderationParameter {
+        ConsiderationParameter::Nop
+    }
+}
+
+/// Out of 100
+struct ConstantConsideration(u32);
+
+impl Consideration<BenchContext> for ConstantConsideration {
+    fn curve(&self) -> Curve {
+        Curve::Identity
+    }
+
+    fn input(&self) -> BenchInput {
+        BenchInput::Constant(self.0)
+    }
+
+    fn parameter(&self) -> ConsiderationParameter {
+        ConsiderationParameter::Nop
+    }
+}
+
+/// Scores from its own constant input, so every DSE does real consideration work
+struct EatDse(u32);
+
+impl Dse<BenchContext> for EatDse {
+    fn name(&self) -> &'static str {
+        "Eat"
+    }
+
+    fn considerations(&self) -> Vec<AiBox<dyn Consideration<BenchContext>>> {
+        vec![
+            AiBox::new(MyHungerConsideration),
+            AiBox::new(ConstantConsideration(self.0)),
+        ]
+    }
+
+    fn weight_type(&self) -> DecisionWeightType {
+        DecisionWeightType::Normal
+    }
+
+    fn action(&self, _: &mut BenchBlackboard) -> BenchAction {
+        BenchAction::Eat
+    }
+}
+
+pub fn choose(c: &mut Criterion) {
+    let mut group = c.benchmark_group("intelligence choose");
+
+    for n in &[4u32, 16, 64] {
+        let dses = (0..*n)
+            .map(|i| AiBox::new(EatDse(30 + (i % 50))) as AiBox<dyn Dse<BenchContext>>)
+            .collect::<Vec<_>>();
+        let mut intelligence = Intelligence::new(dses.into_iter());
+        let mut blackboard = BenchBlackboard { my_hunger: 0.5 };
+
+        group.bench_with_input(BenchmarkId::new("dse count", n), n, |b, _| {
+            b.iter(|| {
+                // decision borrows intelligence and blackboard, drop it inside the closure
+                let decision = intelligence.choose(&mut blackboard);
+                black_box(&decision);
+            })
+        });
+    }
+}
+
+criterion_group!(benches, choose);
+criterion_main!(benches);
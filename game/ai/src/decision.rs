@@ -23,7 +23,7 @@ pub enum DecisionWeight {
     Weighted(DecisionWeightType, f32),
 }
 
-pub trait Dse<C: Context> {
+pub trait Dse<C: Context>: Send + Sync {
     fn name(&self) -> &'static str;
     /// TODO pooled vec/slice rather than Vec each time
     fn considerations(&self) -> Vec<AiBox<dyn Consideration<C>>>;
@@ -34,18 +34,38 @@ pub trait Dse<C: Context> {
         DecisionWeight::Plain(self.weight_type())
     }
 
+    /// `best_so_far` is the best score of any DSE this tick. Each consideration can only
+    /// lower the running product, so evaluation bails out as soon as this DSE can no
+    /// longer beat it. A pruned DSE scores 0.0
     fn score(
         &self,
         blackboard: &mut C::Blackboard,
         input_cache: &mut InputCache<C>,
         bonus: f32,
+        best_so_far: f32,
     ) -> f32 {
+        // the score only ever drops from the initial weight bonus, so skip the whole DSE
+        // if its static weight already caps it below the best
+        if bonus <= best_so_far {
+            trace!(
+                "skipping DSE that cannot beat the best score";
+                "bonus" => bonus, "best" => best_so_far
+            );
+            return 0.0;
+        }
+
         let mut final_score = bonus;
 
         let considerations = self.considerations();
         let modification_factor = 1.0 - (1.0 / considerations.len() as f32);
         for c in considerations.iter() {
-            // TODO optimization: dont consider all considerations every time
+            if final_score <= best_so_far {
+                trace!(
+                    "bailing out of scoring early";
+                    "current" => final_score, "best" => best_so_far
+                );
+                return 0.0;
+            }
 
             let score = c.consider(blackboard, input_cache).value();
 
@@ -79,7 +99,8 @@ pub trait Dse<C: Context> {
 pub struct WeightedDse<C: Context, D: Dse<C>> {
     dse: D,
     additional_weight: f32,
-    phantom: PhantomData<C>,
+    // fn pointer keeps this Send + Sync regardless of C
+    phantom: PhantomData<fn() -> C>,
 }
 
 impl<C: Context> Debug for dyn Dse<C> {
@@ -167,7 +188,20 @@ mod tests {
         let mut blackboard = TestBlackboard { my_hunger: 0.5 };
         let mut cache = InputCache::default();
 
-        assert!(EatDse.score(&mut blackboard, &mut cache, 1.0) > 0.9);
-        assert!(BadDse.score(&mut blackboard, &mut cache, 1.0) < 0.1);
+        assert!(EatDse.score(&mut blackboard, &mut cache, 1.0, 0.0) > 0.9);
+        assert!(BadDse.score(&mut blackboard, &mut cache, 1.0, 0.0) < 0.1);
+    }
+
+    #[test]
+    fn prune_capped_dse() {
+        let mut blackboard = TestBlackboard { my_hunger: 0.5 };
+        let mut cache = InputCache::default();
+
+        // a best score at or above the weight bonus prunes the whole dse
+        assert_eq!(EatDse.score(&mut blackboard, &mut cache, 1.0, 1.0), 0.0);
+        assert_eq!(EatDse.score(&mut blackboard, &mut cache, 1.0, 5.0), 0.0);
+
+        // but a beatable best doesn't
+        assert!(EatDse.score(&mut blackboard, &mut cache, 1.0, 0.5) > 0.9);
     }
 }
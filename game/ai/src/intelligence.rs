@@ -4,7 +4,7 @@ use crate::consideration::InputCache;
 use crate::decision::Dse;
 use crate::{AiBox, Context};
 use common::*;
-use std::cell::Cell;
+use std::cmp::Reverse;
 use std::collections::HashMap;
 
 // TODO pool/arena allocator
@@ -20,7 +20,7 @@ pub struct Intelligence<C: Context> {
     /// Additional, temporary behaviours based on context e.g. in a particular location
     additional: HashMap<C::AdditionalDseId, Smarts<C>>,
 
-    last_action: Cell<C::Action>,
+    last_action: parking_lot::Mutex<C::Action>,
     input_cache: InputCache<C>,
 }
 
@@ -54,28 +54,43 @@ impl<C: Context> Smarts<C> {
         Self { decisions }
     }
 
-    pub fn score(&mut self, input_cache: &mut InputCache<C>, blackboard: &mut C::Blackboard) {
-        let dses = self.decisions.iter_mut().map(Decision::as_mut);
-        Self::score_dses(input_cache, blackboard, dses)
+    /// Returns the best score so far after scoring these DSEs
+    pub fn score(
+        &mut self,
+        input_cache: &mut InputCache<C>,
+        blackboard: &mut C::Blackboard,
+        best_so_far: f32,
+    ) -> f32 {
+        // score in descending weight order, so the high scores most likely to prune the
+        // others are found early
+        let mut dses: SmallVec<[_; 8]> = self.decisions.iter_mut().map(Decision::as_mut).collect();
+        dses.sort_unstable_by_key(|(dse, _)| Reverse(FloatOrd(dse.weight().multiplier())));
+
+        Self::score_dses(input_cache, blackboard, best_so_far, dses.into_iter())
     }
 
     fn score_dses<'dse>(
         input_cache: &mut InputCache<C>,
         blackboard: &mut C::Blackboard,
+        mut best_so_far: f32,
         dses: impl Iterator<Item = (&'dse dyn Dse<C>, &'dse mut f32)>,
-    ) where
+    ) -> f32
+    where
         C: 'dse,
     {
-        // TODO optimize: not all decisions need to be checked each time, but at least zero all scores
         // TODO DSEs should be immutable, with scores stored somewhere else e.g. parallel array
         for (dse, score) in dses {
             // TODO add momentum to discourage changing mind so often
             let bonus = dse.weight().multiplier();
 
             log_scope!(o!("dse" => dse.name()));
-            *score = dse.score(blackboard, input_cache, bonus);
+            *score = dse.score(blackboard, input_cache, bonus, best_so_far);
             trace!("DSE scored {score}", score = *score);
+
+            best_so_far = best_so_far.max(*score);
         }
+
+        best_so_far
     }
 }
 
@@ -110,10 +125,11 @@ impl<C: Context> Intelligence<C> {
     {
         self.input_cache.reset();
 
-        // score all possible decisions
-        self.base.score(&mut self.input_cache, blackboard);
+        // score all possible decisions, tracking the best score so far to prune DSEs
+        // that can't beat it
+        let mut best_so_far = self.base.score(&mut self.input_cache, blackboard, 0.0);
         for (_, smarts) in self.additional.iter_mut() {
-            smarts.score(&mut self.input_cache, blackboard)
+            best_so_far = smarts.score(&mut self.input_cache, blackboard, best_so_far);
         }
 
         // score streams in a parallel array of scores
@@ -122,6 +138,7 @@ impl<C: Context> Intelligence<C> {
         Smarts::score_dses(
             &mut self.input_cache,
             blackboard,
+            best_so_far,
             streams.iter_mut().map(|(dse, score)| (*dse, score)),
         );
 
@@ -143,7 +160,7 @@ impl<C: Context> Intelligence<C> {
         trace!("intelligence chose {dse}", dse = choice.name(); "source" => ?choice_src);
 
         let action = choice.action(blackboard);
-        let last_action = self.last_action.replace(action.clone());
+        let last_action = std::mem::replace(&mut *self.last_action.lock(), action.clone());
 
         if action == last_action {
             IntelligentDecision::Unchanged
@@ -214,7 +231,7 @@ impl<C: Context> Intelligence<C> {
     }
 
     pub fn clear_last_action(&mut self) {
-        self.last_action.replace(C::Action::default());
+        *self.last_action.lock() = C::Action::default();
     }
 }
 
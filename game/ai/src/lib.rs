@@ -13,11 +13,11 @@ mod intelligence;
 pub trait Context: Sized {
     type Blackboard: Blackboard;
     type Input: Input<Self>;
-    type Action: Default + Eq + Clone;
-    type AdditionalDseId: Hash + Eq + Clone + Debug;
+    type Action: Default + Eq + Clone + Send + Sync;
+    type AdditionalDseId: Hash + Eq + Clone + Debug + Send + Sync;
 }
 
-pub trait Input<C: Context>: Hash + Clone + Eq {
+pub trait Input<C: Context>: Hash + Clone + Eq + Send + Sync {
     fn get(&self, blackboard: &mut C::Blackboard) -> f32;
 }
 
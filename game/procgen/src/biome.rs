@@ -3,11 +3,12 @@ use crate::{map_range, PlanetParams, RegionLocation};
 use common::*;
 use noise::{Fbm, NoiseFn, Seedable};
 
-use crate::region::PlanetPoint;
+use crate::region::{PlanetPoint, PlanetPointPrecalculated};
 use rstar::{Envelope, Point, RTree, AABB};
 use serde::de::DeserializeOwned;
 use serde::Deserialize;
 use std::f64::consts::{PI, TAU};
+use unit::world::{BlockPosition, CHUNK_SIZE};
 
 pub(crate) use deserialize::BiomeConfig;
 
@@ -120,6 +121,19 @@ pub struct BlockQueryResult {
     pub region: Option<(RegionLocation, SmallVec<[String; 4]>)>,
 }
 
+/// Blocks in a chunk footprint
+const CHUNK_FOOTPRINT: usize = CHUNK_SIZE.as_usize() * CHUNK_SIZE.as_usize();
+
+/// Per-block sample planes for a whole chunk footprint, filled by
+/// [BiomeSampler::sample_chunk] in one batch. Contiguous in the same row-major
+/// (y outer, x inner) order as chunk block iteration
+pub struct ChunkSamples {
+    pub coastline_proximity: [f64; CHUNK_FOOTPRINT],
+    pub elevation: [f64; CHUNK_FOOTPRINT],
+    pub moisture: [f64; CHUNK_FOOTPRINT],
+    pub temperature: [f64; CHUNK_FOOTPRINT],
+}
+
 /// Noise generator with its rough limits
 struct Noise<N: NoiseFn<[f64; 4]>> {
     noise: N,
@@ -183,6 +197,84 @@ impl BiomeSampler {
         (coastline_proximity, elevation, moisture, temperature)
     }
 
+    /// Batch form of [Self::sample] over a whole chunk footprint, filling contiguous
+    /// per-block planes in one call instead of issuing scalar lookups per block. The
+    /// wrapped noise coordinates and latitude factors only vary along one axis each, so
+    /// they are hoisted out to per-row/column calculations and the inner loops run
+    /// straight over the output arrays
+    pub fn sample_chunk(
+        &self,
+        precalc: &PlanetPointPrecalculated,
+        continents: &ContinentMap,
+    ) -> Box<ChunkSamples> {
+        let n = CHUNK_SIZE.as_usize();
+
+        // planet coordinates of each column and row
+        let mut xs = [0.0; CHUNK_SIZE.as_usize()];
+        let mut ys = [0.0; CHUNK_SIZE.as_usize()];
+        for i in 0..n {
+            let point = PlanetPoint::with_precalculated(
+                precalc,
+                BlockPosition::new_unchecked(i as u8, i as u8, 0.into()),
+            );
+            xs[i] = point.x();
+            ys[i] = point.y();
+        }
+
+        // too big for the stack of an async task
+        let mut samples = Box::new(ChunkSamples {
+            coastline_proximity: [0.0; CHUNK_FOOTPRINT],
+            elevation: [0.0; CHUNK_FOOTPRINT],
+            moisture: [0.0; CHUNK_FOOTPRINT],
+            temperature: [0.0; CHUNK_FOOTPRINT],
+        });
+
+        // raw noise planes, combined in place below
+        self.height
+            .sample_grid_wrapped_normalized(&xs, &ys, &mut samples.elevation);
+        self.moisture
+            .sample_grid_wrapped_normalized(&xs, &ys, &mut samples.moisture);
+        self.temperature
+            .sample_grid_wrapped_normalized(&xs, &ys, &mut samples.temperature);
+
+        for (iy, &y) in ys.iter().enumerate() {
+            for (ix, &x) in xs.iter().enumerate() {
+                samples.coastline_proximity[iy * n + ix] =
+                    continents.coastline_proximity(PlanetPoint::new(x, y));
+            }
+        }
+
+        // combine raw planes with the same formulas as the scalar path
+        for (iy, &y) in ys.iter().enumerate() {
+            let latitude = self.latitude_mul(y);
+            let moisture_latitude = map_range((0.0, 1.0), (0.8, 1.2), 1.0 - latitude).min(1.0);
+
+            for i in iy * n..(iy + 1) * n {
+                let coast = samples.coastline_proximity[i];
+
+                let elevation = if coast >= 0.0 {
+                    samples.elevation[i] * coast
+                } else {
+                    0.0
+                };
+                samples.elevation[i] = elevation;
+
+                samples.moisture[i] = if coast < 0.0 {
+                    1.0
+                } else {
+                    let mul = map_range((0.0, 1.0), (0.8, 1.2), 1.0 - coast);
+                    samples.moisture[i] * mul * moisture_latitude
+                };
+
+                samples.temperature[i] = (samples.temperature[i] * 0.25)
+                    + ((1.0 - elevation) * 0.15)
+                    + (latitude * 0.6);
+            }
+        }
+
+        samples
+    }
+
     pub fn choose_biomes(
         &self,
         coast_proximity: f64,
@@ -361,6 +453,43 @@ impl<N: NoiseFn<[f64; 4]>> Noise<N> {
         let value = self.sample_wrapped(pos);
         map_range(self.limits, (0.0, 1.0), value)
     }
+
+    /// Batch form of [Self::sample_wrapped_normalized] over the cartesian product of
+    /// the given planet coordinates, writing into `out` with y as the outer axis. Each
+    /// wrapped 4d coordinate depends on only one input axis, so the trigonometry runs
+    /// once per row and column and the inner loop is a plain noise evaluation over
+    /// contiguous output
+    fn sample_grid_wrapped_normalized(&self, xs: &[f64], ys: &[f64], out: &mut [f64]) {
+        debug_assert_eq!(out.len(), xs.len() * ys.len());
+
+        // noise range, as in sample_wrapped
+        let x1 = 0.0;
+        let y1 = 0.0;
+        let dx = 2.0;
+        let dy = 2.0;
+
+        let x_coords = xs
+            .iter()
+            .map(|&x| {
+                let s = x / self.planet_size;
+                (
+                    x1 + (s * TAU).cos() * dx / TAU,
+                    x1 + (s * TAU).sin() * dx / TAU,
+                )
+            })
+            .collect::<SmallVec<[(f64, f64); 16]>>();
+
+        for (iy, &y) in ys.iter().enumerate() {
+            let t = y / self.planet_size;
+            let ny = y1 + (t * TAU).cos() * dy / TAU;
+            let nw = y1 + (t * TAU).sin() * dy / TAU;
+
+            let row = &mut out[iy * xs.len()..(iy + 1) * xs.len()];
+            for (&(nx, nz), value) in x_coords.iter().zip(row) {
+                *value = map_range(self.limits, (0.0, 1.0), self.noise.get([nx, ny, nz, nw]));
+            }
+        }
+    }
 }
 
 impl BiomeChoices {
@@ -692,6 +821,32 @@ mod tests {
         assert_eq!(a.sample(pos, &continents), b.sample(pos, &continents));
     }
 
+    #[test]
+    fn batch_sampling_matches_scalar() {
+        let params = PlanetParams::dummy();
+        let continents = ContinentMap::new_with_rng(params.clone(), &mut thread_rng());
+        let sampler = BiomeSampler::new(&mut StdRng::seed_from_u64(1234), &params).unwrap();
+
+        let precalc = PlanetPoint::precalculate(RegionLocation::new(1, 1), 3);
+        let samples = sampler.sample_chunk(&precalc, &continents);
+
+        for (i, (by, bx)) in (0..CHUNK_SIZE.as_u8())
+            .cartesian_product(0..CHUNK_SIZE.as_u8())
+            .enumerate()
+        {
+            let point = PlanetPoint::with_precalculated(
+                &precalc,
+                BlockPosition::new_unchecked(bx, by, 0.into()),
+            );
+            let (coast, elevation, moisture, temperature) = sampler.sample(point, &continents);
+
+            assert_eq!(samples.coastline_proximity[i], coast);
+            assert_eq!(samples.elevation[i], elevation);
+            assert_eq!(samples.moisture[i], moisture);
+            assert_eq!(samples.temperature[i], temperature);
+        }
+    }
+
     #[test]
     fn biome_choice_order() {
         let nearest_neighbours = vec![
@@ -1,10 +1,17 @@
 use crate::continent::ContinentMap;
 use crate::planet::PlanetInner;
+use crate::rasterize::{BlockType, SlabGrid};
 use crate::PlanetParams;
 use common::*;
+use grid::GridImpl;
+use memmap::Mmap;
+use parking_lot::Mutex;
 use sha2::{Digest, Sha256};
-use std::fs::OpenOptions;
+use std::collections::HashMap;
+use std::fs::{File, OpenOptions};
+use std::io::Write;
 use std::path::PathBuf;
+use unit::world::SlabLocation;
 
 pub fn save(planet: &PlanetInner) -> BoxedResult<()> {
     let path = cache_file(&planet.params);
@@ -34,6 +41,157 @@ pub fn try_load(params: &PlanetParams) -> BoxedResult<Option<ContinentMap>> {
         .map_err(Into::into)
 }
 
+/// Slab location as 3 little endian i32s
+const SLAB_KEY_SIZE: usize = 12;
+
+/// Size of one slab record: location key followed by one byte per block
+const SLAB_RECORD_SIZE: usize = SLAB_KEY_SIZE + SlabGrid::FULL_SIZE;
+
+/// Persistent store of generated slab terrain, bypassing region and feature generation
+/// entirely for slabs produced in a previous session. Slabs are appended as fixed size
+/// records when they finish generating, and the file is memory mapped on startup so a
+/// hit is a single copy out of the mapped pages with no parse step. Invalidated by the
+/// params hash in the file name, like the continent cache above
+pub struct SlabCache {
+    /// Append handle for newly generated slabs
+    file: Mutex<File>,
+
+    /// Records present at startup, None if the store was empty
+    map: Option<Mmap>,
+
+    /// Payload offset in `map` of each slab present at startup
+    index: HashMap<SlabLocation, usize>,
+}
+
+impl SlabCache {
+    pub fn open(params: &PlanetParams) -> BoxedResult<Self> {
+        let path = slab_store_file(params);
+        std::fs::create_dir_all(path.parent().unwrap())?;
+
+        let file = OpenOptions::new()
+            .read(true)
+            .append(true)
+            .create(true)
+            .open(&path)?;
+
+        // ignore a trailing partial record from an interrupted write
+        let len = file.metadata()?.len() as usize;
+        let whole_records = len - (len % SLAB_RECORD_SIZE);
+
+        let (map, index) = if whole_records == 0 {
+            (None, HashMap::new())
+        } else {
+            // safety: the store is append-only, the mapped startup range is never
+            // modified again
+            let map = unsafe { Mmap::map(&file)? };
+            let mut index = HashMap::with_capacity(whole_records / SLAB_RECORD_SIZE);
+
+            for offset in (0..whole_records).step_by(SLAB_RECORD_SIZE) {
+                let slab = read_slab_key(&map[offset..offset + SLAB_KEY_SIZE]);
+
+                // later duplicates win, appends act as overwrites
+                index.insert(slab, offset + SLAB_KEY_SIZE);
+            }
+
+            (Some(map), index)
+        };
+
+        info!(
+            "opened slab store with {count} cached slabs",
+            count = index.len();
+            "file" => %path.display()
+        );
+
+        Ok(Self {
+            file: Mutex::new(file),
+            map,
+            index,
+        })
+    }
+
+    /// Reads a slab generated in an earlier session straight out of the mapped pages
+    pub fn read_slab(&self, slab: SlabLocation) -> Option<SlabGrid> {
+        let offset = *self.index.get(&slab)?;
+        let payload = &self.map.as_ref()?[offset..offset + SlabGrid::FULL_SIZE];
+
+        let mut grid = SlabGrid::default();
+        for (block, &byte) in grid.array_mut().iter_mut().zip(payload) {
+            // bail out on a corrupt record and regenerate instead
+            block.ty = block_type_from_byte(byte)?;
+        }
+
+        Some(grid)
+    }
+
+    /// Appends the slab to the store, to be indexed on the next startup
+    pub fn write_slab(&self, slab: SlabLocation, terrain: &SlabGrid) -> BoxedResult<()> {
+        if self.index.contains_key(&slab) {
+            // already stored
+            return Ok(());
+        }
+
+        let mut record = Vec::with_capacity(SLAB_RECORD_SIZE);
+        write_slab_key(&mut record, slab);
+        record.extend(terrain.array().iter().map(|b| block_type_to_byte(b.ty)));
+
+        self.file.lock().write_all(&record)?;
+        Ok(())
+    }
+}
+
+fn write_slab_key(out: &mut Vec<u8>, slab: SlabLocation) {
+    out.extend_from_slice(&slab.chunk.0.to_le_bytes());
+    out.extend_from_slice(&slab.chunk.1.to_le_bytes());
+    out.extend_from_slice(&slab.slab.as_i32().to_le_bytes());
+}
+
+fn read_slab_key(bytes: &[u8]) -> SlabLocation {
+    let int = |i: usize| {
+        let mut buf = [0u8; 4];
+        buf.copy_from_slice(&bytes[i * 4..(i + 1) * 4]);
+        i32::from_le_bytes(buf)
+    };
+
+    SlabLocation::new(int(2), (int(0), int(1)))
+}
+
+fn block_type_to_byte(ty: BlockType) -> u8 {
+    match ty {
+        BlockType::Air => 0,
+        BlockType::Stone => 1,
+        BlockType::Dirt => 2,
+        BlockType::LightGrass => 3,
+        BlockType::Leaves => 4,
+        BlockType::TreeTrunk => 5,
+        BlockType::Grass => 6,
+        BlockType::Sand => 7,
+        BlockType::SolidWater => 8,
+    }
+}
+
+fn block_type_from_byte(byte: u8) -> Option<BlockType> {
+    Some(match byte {
+        0 => BlockType::Air,
+        1 => BlockType::Stone,
+        2 => BlockType::Dirt,
+        3 => BlockType::LightGrass,
+        4 => BlockType::Leaves,
+        5 => BlockType::TreeTrunk,
+        6 => BlockType::Grass,
+        7 => BlockType::Sand,
+        8 => BlockType::SolidWater,
+        _ => return None,
+    })
+}
+
+fn slab_store_file(params: &PlanetParams) -> PathBuf {
+    let mut path = std::env::temp_dir();
+    path.push("nn-procgen-cache");
+    path.push(hash(params));
+    path.set_extension("slabs");
+    path
+}
+
 fn cache_file(params: &PlanetParams) -> PathBuf {
     let mut path = std::env::temp_dir();
     path.push("nn-procgen-cache");
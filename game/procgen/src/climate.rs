@@ -98,6 +98,16 @@ impl<T: Default> PlanetGrid<T> {
     }
 }
 
+impl<T: Default + Send> PlanetGrid<T> {
+    /// Runs `f` on every cell in parallel. `f` is only given a mutable reference to its
+    /// own cell, so it must read any cross-cell state from a separate grid holding the
+    /// previous step's values (double buffering), making the result independent of band
+    /// order and count.
+    fn par_compute_bands(&mut self, f: impl Fn([usize; 3], &mut T) + Sync) {
+        self.0.par_map_in_place(f)
+    }
+}
+
 impl<T: Default + Real + AddAssign + DivAssign + From<f64>> PlanetGrid<T> {
     pub fn iter_average(&self, layer: AirLayer, mut f: impl FnMut([usize; 2], T)) {
         match layer {
@@ -277,7 +287,10 @@ mod iteration {
             let dir_conform = self.params.wind_direction_conformity;
 
             let terrain = &self.height_gradient;
-            for (coord, wind) in self.wind.iter_individual_layers() {
+            let old_wind = &self.wind;
+            new_vals.par_compute_bands(|coord, new_wind| {
+                let wind = &old_wind.0[coord];
+
                 // speed up when going downhill or flat, slow down going up
                 let land_gradient = {
                     let angle = wind.velocity.angle(Vector3::unit_y()).normalize();
@@ -294,10 +307,11 @@ mod iteration {
                 debug_assert!(speed_modifier.is_sign_positive());
 
                 let new_vel = wind.velocity * speed_modifier;
-                new_vals.0[coord].velocity = wind.velocity.lerp(new_vel, dir_conform);
-            }
+                new_wind.velocity = wind.velocity.lerp(new_vel, dir_conform);
+            });
 
-            // propagate forwards
+            // propagate forwards, scattering into arbitrary destination cells so this stays
+            // single threaded
             for (coord, this_wind) in self.wind.iter_individual_layers() {
                 let [x, y, z] = coord;
 
@@ -312,9 +326,9 @@ mod iteration {
                 new_vals.0[dest_coord].velocity += this_wind.velocity;
             }
 
-            for (_, wind) in new_vals.iter_individual_layers_mut() {
+            new_vals.par_compute_bands(|_, wind| {
                 wind.velocity = truncate(wind.velocity, 1.0);
-            }
+            });
 
             let _old = std::mem::replace(&mut self.wind, new_vals);
         }
@@ -356,7 +370,8 @@ mod iteration {
             }
         }
 
-        /// Calculate wind velocities based on air pressure differences
+        /// Calculate wind velocities based on air pressure differences. Each cell reads only
+        /// the untouched pressure grid and writes its own wind, so bands run concurrently
         fn make_wind(&mut self) {
             let air_pressure = &self.air_pressure;
             let threshold = self.params.wind_pressure_threshold;
@@ -372,7 +387,7 @@ mod iteration {
                 }};
             }
 
-            for (coord, wind) in self.wind.iter_individual_layers_mut() {
+            self.wind.par_compute_bands(|coord, wind| {
                 let mut explore_state = Some((
                     air_pressure.0.flatten_coords(coord),
                     [coord[0] as isize, coord[1] as isize, coord[2] as isize],
@@ -421,7 +436,7 @@ mod iteration {
                 };
 
                 wind.velocity = wind.velocity.lerp(new_wind, dir_conform);
-            }
+            });
         }
 
         /// Warm surface air rises, so surface pressure decreases.
@@ -607,4 +622,19 @@ mod tests {
         grid.iter_layer(AirLayer::High)
             .for_each(|(_, val)| assert_eq!(*val, 5));
     }
+
+    #[test]
+    fn planet_grid_banded_compute() {
+        let mut grid = grid::<i32>(8);
+
+        // every cell should be visited exactly once with its real coord
+        grid.par_compute_bands(|[x, y, z], val| {
+            assert_eq!(*val, 0);
+            *val = (x + y * 10 + z * 100) as i32;
+        });
+
+        for ([x, y, z], val) in grid.0.iter_coords() {
+            assert_eq!(*val, (x + y * 10 + z * 100) as i32);
+        }
+    }
 }
@@ -42,6 +42,10 @@ pub struct PlanetInner {
 
     #[cfg(feature = "cache")]
     was_loaded: bool,
+
+    /// Persistent store of generated slab terrain for instant restarts
+    #[cfg(feature = "cache")]
+    slab_cache: Option<crate::cache::SlabCache>,
 }
 
 impl Planet {
@@ -71,6 +75,19 @@ impl Planet {
         let was_loaded = continents.is_some();
         let continents = continents.unwrap_or_else(|| ContinentMap::new(params.clone()));
 
+        #[cfg(feature = "cache")]
+        let slab_cache = if params.no_cache {
+            None
+        } else {
+            match crate::cache::SlabCache::open(&params) {
+                Ok(cache) => Some(cache),
+                Err(e) => {
+                    error!("failed to open slab store: {}", e);
+                    None
+                }
+            }
+        };
+
         let regions = Regions::new(params.clone());
         let inner = Arc::new(RwLock::new(PlanetInner {
             params,
@@ -83,6 +100,9 @@ impl Planet {
 
             #[cfg(feature = "cache")]
             was_loaded,
+
+            #[cfg(feature = "cache")]
+            slab_cache,
         }));
 
         Ok(Self(inner))
@@ -179,6 +199,19 @@ impl Planet {
     /// Generates now and does not cache. Returns None if slab is out of range
     pub async fn generate_slab(&self, slab: SlabLocation) -> Option<SlabGrid> {
         let inner = self.0.read().await;
+
+        // skip generation entirely if the slab is in the persistent store from an
+        // earlier session
+        #[cfg(feature = "cache")]
+        if let Some(terrain) = inner
+            .slab_cache
+            .as_ref()
+            .and_then(|cache| cache.read_slab(slab))
+        {
+            debug!("using slab terrain from persistent store"; slab);
+            return Some(terrain);
+        }
+
         let params = inner.params.clone();
         let slab_continuations = inner.regions.slab_continuations();
         let world_updates = inner.world_updates.clone();
@@ -254,6 +287,17 @@ impl Planet {
             }
         }
 
+        // persist finished terrain for instant restarts
+        #[cfg(feature = "cache")]
+        {
+            let inner = self.0.read().await;
+            if let Some(cache) = inner.slab_cache.as_ref() {
+                if let Err(e) = cache.write_slab(slab, &terrain) {
+                    error!("failed to write slab to persistent store: {}", e);
+                }
+            }
+        }
+
         Some(terrain)
     }
 
@@ -277,8 +321,18 @@ impl Planet {
             .filter_map(|(cx, cy)| RegionLocation::try_from_chunk(ChunkLocation(cx, cy))) // TODO
             .dedup();
 
-        for region in regions {
-            self.realize_region(region).await;
+        // realize distinct regions concurrently on the worker runtime - creation is
+        // independent between regions, with each behind its own lock and only the
+        // continuation exchange synchronized internally by get_or_create
+        let tasks = regions
+            .map(|region| {
+                let planet = self.clone();
+                tokio::spawn(async move { planet.realize_region(region).await })
+            })
+            .collect_vec();
+
+        for task in tasks {
+            task.await.expect("region realization panicked");
         }
     }
 
@@ -11,6 +11,7 @@ mod subfeatures;
 mod unit;
 
 pub use feature::{ApplyFeatureContext, Feature, RegionalFeature};
+pub use unit::PlanetPointPrecalculated;
 pub(crate) use subfeature::SlabContinuation;
 
 /// Each region is broken up into this many chunks per side, i.e. this^2 for total number of chunks
@@ -12,7 +12,7 @@ pub use ::unit::world::{
 };
 use common::*;
 use grid::{grid_declare, GridImpl};
-use unit::world::{BlockPosition, SlabLocation, SlabPosition};
+use unit::world::{SlabLocation, SlabPosition};
 
 use crate::biome::BiomeType;
 use crate::continent::ContinentMap;
@@ -512,21 +512,21 @@ impl<const SIZE: usize> RegionChunk<SIZE> {
         let precalc = PlanetPoint::precalculate(region, chunk_idx);
         let sampler = continents.biome_sampler();
 
+        // sample all noise planes for the chunk footprint in one batch, in the same
+        // row-major order as the block loop below
+        let samples = sampler.sample_chunk(&precalc, continents);
+
         // get height for each surface block in chunk
         let mut height_map = ChunkHeightMap::default();
         let (mut min_height, mut max_height) = (i32::MAX, i32::MIN);
-        for (i, (by, bx)) in (0..CHUNK_SIZE.as_u8())
-            .cartesian_product(0..CHUNK_SIZE.as_u8())
-            .enumerate()
-        {
-            let point = PlanetPoint::with_precalculated(
-                &precalc,
-                BlockPosition::new_unchecked(bx, by, 0.into()),
+        for i in 0..samples.coastline_proximity.len() {
+            let (coastal, base_elevation, temperature, moisture) = (
+                samples.coastline_proximity[i],
+                samples.elevation[i],
+                samples.temperature[i],
+                samples.moisture[i],
             );
 
-            let (coastal, base_elevation, moisture, temperature) =
-                sampler.sample(point, continents);
-
             let biome_choices =
                 sampler.choose_biomes(coastal, base_elevation, temperature, moisture);
             let biome = biome_choices.primary();
@@ -4,7 +4,7 @@ use memmap::Mmap;
 use std::ffi::OsStr;
 use std::fs::File;
 use std::path::{Path, PathBuf};
-use std::rc::Rc;
+use std::sync::Arc;
 use walkdir::WalkDir;
 
 /// Represents a directory
@@ -122,7 +122,7 @@ pub fn recurse<R: ResourceContainer, T: ReadResource>(
         .map(T::read_resource)
 }
 
-impl ReadResource for (File, Mmap, Rc<Path>) {
+impl ReadResource for (File, Mmap, Arc<Path>) {
     fn read_resource(path: impl AsRef<ResourcePath>) -> Result<Self, ResourceError> {
         let path = path.as_ref();
         let file = File::open(&path.0);
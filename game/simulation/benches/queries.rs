@@ -0,0 +1,105 @@
+use criterion::{black_box, criterion_group, criterion_main, Criterion};
+
+use common::*;
+use simulation::benchmark_exports::*;
+use simulation::{ComponentWorld, EcsWorld, Entity, PhysicalComponent, TransformComponent};
+use specs::{Builder, RunNow, WorldExt};
+use unit::space::length::Length3;
+use unit::space::volume::Volume;
+use unit::world::WorldPoint;
+
+pub fn spatial_queries(c: &mut Criterion) {
+    const ENTITIES: usize = 5000;
+    const WORLD_SIZE: f32 = 512.0;
+    const RADIUS: f32 = 10.0;
+
+    let mut rng = thread_rng();
+    let mut world = EcsWorld::new();
+    world.insert(Spatial::default());
+
+    for _ in 0..ENTITIES {
+        let pos = WorldPoint::new_unchecked(
+            rng.gen_range(0.0, WORLD_SIZE),
+            rng.gen_range(0.0, WORLD_SIZE),
+            rng.gen_range(0.0, 64.0),
+        );
+        world
+            .create_entity()
+            .with(TransformComponent::new(pos))
+            .with(PhysicalComponent::new(
+                Volume::from(1u16),
+                Length3::new(1, 1, 1),
+            ))
+            .build();
+    }
+    world.maintain();
+    SpatialSystem.run_now(&*world);
+
+    let centres: Vec<WorldPoint> = (0..100)
+        .map(|_| {
+            WorldPoint::new_unchecked(
+                rng.gen_range(0.0, WORLD_SIZE),
+                rng.gen_range(0.0, WORLD_SIZE),
+                rng.gen_range(0.0, 64.0),
+            )
+        })
+        .collect();
+
+    let spatial = world.resource::<Spatial>();
+
+    c.bench_function("spatial query in radius", |b| {
+        let mut centres = centres.iter().cycle();
+        b.iter(|| {
+            let centre = *centres.next().unwrap();
+            black_box(spatial.query_in_radius(centre, RADIUS).count())
+        })
+    });
+
+    let queries: Vec<(WorldPoint, f32)> = centres.iter().map(|c| (*c, RADIUS)).collect();
+    c.bench_function("spatial query in radius batch", |b| {
+        b.iter(|| {
+            let mut hits = 0usize;
+            spatial.query_in_radius_batch(&queries, |_, _, _, _| hits += 1);
+            black_box(hits);
+        })
+    });
+}
+
+pub fn event_queue(c: &mut Criterion) {
+    const ENTITIES: usize = 100;
+
+    let world = EcsWorld::new();
+    let entities: Vec<Entity> = (0..ENTITIES)
+        .map(|_| world.create_entity().build())
+        .collect();
+
+    let mut queue = EntityEventQueue::default();
+    for pair in entities.windows(2) {
+        queue.subscribe(
+            pair[1],
+            once(EntityEventSubscription(pair[0], EventSubscription::All)),
+        );
+    }
+
+    c.bench_function("post and consume events", |b| {
+        b.iter(|| {
+            for e in entities.iter() {
+                queue.post(EntityEvent {
+                    subject: *e,
+                    payload: EntityEventPayload::HasEaten(*e),
+                });
+            }
+
+            queue.consume_events(
+                |_, event| {
+                    black_box(event);
+                    EventUnsubscribeResult::StaySubscribed
+                },
+                |_| {},
+            );
+        })
+    });
+}
+
+criterion_group!(benches, spatial_queries, event_queue);
+criterion_main!(benches);
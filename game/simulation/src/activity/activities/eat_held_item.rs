@@ -35,7 +35,7 @@ enum EatHeldItemState {
 }
 
 impl<W: ComponentWorld> Activity<W> for EatHeldItemActivity {
-    fn on_tick<'a>(&mut self, ctx: &'a mut ActivityContext<'_, W>) -> ActivityResult {
+    fn on_tick<'a>(&mut self, ctx: &'a mut ActivityContext<'_, '_, W>) -> ActivityResult {
         if let Some(result) = self.finished.take() {
             return ActivityResult::from(result);
         }
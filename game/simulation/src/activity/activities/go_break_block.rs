@@ -24,7 +24,7 @@ pub struct GoBreakBlockActivity {
 }
 
 impl<W: ComponentWorld> Activity<W> for GoBreakBlockActivity {
-    fn on_tick<'a>(&mut self, ctx: &'a mut ActivityContext<'_, W>) -> ActivityResult {
+    fn on_tick<'a>(&mut self, ctx: &'a mut ActivityContext<'_, '_, W>) -> ActivityResult {
         if let Some(res) = self.finished.take() {
             return ActivityResult::from(res);
         }
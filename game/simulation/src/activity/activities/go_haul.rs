@@ -65,7 +65,7 @@ impl HaulActivity {
 }
 
 impl<W: ComponentWorld> Activity<W> for HaulActivity {
-    fn on_tick<'a>(&mut self, ctx: &'a mut ActivityContext<'_, W>) -> ActivityResult {
+    fn on_tick<'a>(&mut self, ctx: &'a mut ActivityContext<'_, '_, W>) -> ActivityResult {
         match std::mem::replace(&mut self.state, HaulState::Dummy) {
             HaulState::Start => {
                 // find source position
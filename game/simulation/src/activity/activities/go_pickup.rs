@@ -49,7 +49,7 @@ enum PickupFailure {
 }
 
 impl<W: ComponentWorld> Activity<W> for PickupItemsActivity {
-    fn on_tick<'a>(&mut self, ctx: &'a mut ActivityContext<'_, W>) -> ActivityResult {
+    fn on_tick<'a>(&mut self, ctx: &'a mut ActivityContext<'_, '_, W>) -> ActivityResult {
         if self.complete {
             return ActivityResult::Finished(ActivityFinish::Success);
         }
@@ -251,7 +251,7 @@ impl PickupItemsActivity {
             }
 
             (None, Some(err)) => {
-                let err: Box<dyn Error> = match err {
+                let err: Box<dyn Error + Send + Sync> = match err {
                     PickupFailure::PickupError(e) => Box::new(e),
                     PickupFailure::NavigationError(e) => Box::new(e),
                     PickupFailure::Other => Box::new(PickupItemError::NotAvailable),
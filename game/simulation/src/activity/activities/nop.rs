@@ -10,7 +10,7 @@ const WARN_THRESHOLD: u32 = 50;
 pub struct NopActivity(u32);
 
 impl<W: ComponentWorld> Activity<W> for NopActivity {
-    fn on_tick<'a>(&mut self, _: &'a mut ActivityContext<'_, W>) -> ActivityResult {
+    fn on_tick<'a>(&mut self, _: &'a mut ActivityContext<'_, '_, W>) -> ActivityResult {
         self.0 += 1;
         if self.0 >= WARN_THRESHOLD {
             warn!(
@@ -46,7 +46,7 @@ pub enum WanderError {
 const WANDER_RADIUS: u16 = 10;
 
 impl<W: ComponentWorld> Activity<W> for WanderActivity {
-    fn on_tick<'a>(&mut self, ctx: &'a mut ActivityContext<'_, W>) -> ActivityResult {
+    fn on_tick<'a>(&mut self, ctx: &'a mut ActivityContext<'_, '_, W>) -> ActivityResult {
         match self.state {
             WanderState::Wandering(count) => {
                 trace!(
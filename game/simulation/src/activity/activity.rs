@@ -2,7 +2,7 @@ use common::*;
 
 use crate::ComponentWorld;
 
-use crate::ecs::Entity;
+use crate::ecs::{Entity, FrameVec};
 use crate::event::{
     EntityEvent, EntityEventSubscription, EntityTimers, EventSubscription, TimerToken,
 };
@@ -32,16 +32,17 @@ pub enum EventUnsubscribeResult {
 #[derive(Debug)]
 pub enum ActivityFinish {
     Success,
-    Failure(Box<dyn Error>),
+    Failure(Box<dyn Error + Send + Sync>),
     Interrupted,
 }
 
-pub struct ActivityContext<'a, W: ComponentWorld> {
+pub struct ActivityContext<'a, 'frame, W: ComponentWorld> {
     pub entity: Entity,
     /// Immutable getters only! Use lazy_updates for adding/removing components
     pub world: &'a W,
     pub updates: &'a QueuedUpdates,
-    pub subscriptions: &'a mut Vec<EntityEventSubscription>,
+    /// Scratch allocation from this tick's frame arena
+    pub subscriptions: &'a mut FrameVec<'frame, EntityEventSubscription>,
 }
 
 pub struct ActivityEventContext {
@@ -51,8 +52,8 @@ pub struct ActivityEventContext {
 #[derive(Error, Debug)]
 #[error("Both activity and subactivity failed to finish. Activity: {activity}. Subactivity: {subactivity}")]
 pub struct ColossalActivityFailure {
-    activity: Box<dyn Error>,
-    subactivity: Box<dyn Error>,
+    activity: Box<dyn Error + Send + Sync>,
+    subactivity: Box<dyn Error + Send + Sync>,
 }
 
 #[macro_export]
@@ -68,8 +69,8 @@ macro_rules! unexpected_event {
     };
 }
 
-pub trait Activity<W: ComponentWorld>: Display + Debug {
-    fn on_tick<'a>(&mut self, ctx: &'a mut ActivityContext<'_, W>) -> ActivityResult;
+pub trait Activity<W: ComponentWorld>: Display + Debug + Send + Sync {
+    fn on_tick<'a>(&mut self, ctx: &'a mut ActivityContext<'_, '_, W>) -> ActivityResult;
 
     #[allow(unused_variables)]
     fn on_event(
@@ -114,7 +115,7 @@ pub trait SubActivity<W: ComponentWorld>: Display {
     fn exertion(&self) -> f32;
 }
 
-impl<'a, W: ComponentWorld> ActivityContext<'a, W> {
+impl<'a, 'frame, W: ComponentWorld> ActivityContext<'a, 'frame, W> {
     pub fn subscribe_to(&mut self, subject_entity: Entity, subscription: EventSubscription) {
         self.subscriptions
             .push(EntityEventSubscription(subject_entity, subscription));
@@ -134,7 +135,7 @@ impl<'a, W: ComponentWorld> ActivityContext<'a, W> {
 }
 
 impl ActivityResult {
-    pub fn errored<E: Error + 'static>(err: E) -> Self {
+    pub fn errored<E: Error + Send + Sync + 'static>(err: E) -> Self {
         Self::Finished(ActivityFinish::Failure(Box::new(err)))
     }
 }
@@ -1,5 +1,4 @@
-use std::cell::Cell;
-
+use common::parking_lot::Mutex;
 use common::*;
 use unit::world::WorldPoint;
 
@@ -11,12 +10,23 @@ use crate::ComponentWorld;
 use world::SearchGoal;
 
 /// Assigns path to navigate to given pos. Blocks on arrival event
-#[derive(Clone, Debug)]
+#[derive(Debug)]
 pub struct GoToSubActivity {
     target: WorldPoint,
     speed: NormalizedFloat,
     goal: SearchGoal,
-    token: Cell<Option<PathToken>>,
+    token: Mutex<Option<PathToken>>,
+}
+
+impl Clone for GoToSubActivity {
+    fn clone(&self) -> Self {
+        Self {
+            target: self.target,
+            speed: self.speed,
+            goal: self.goal,
+            token: Mutex::new(*self.token.lock()),
+        }
+    }
 }
 
 impl GoToSubActivity {
@@ -29,13 +39,13 @@ impl GoToSubActivity {
             target,
             speed,
             goal,
-            token: Cell::new(None),
+            token: Mutex::new(None),
         }
     }
 
     /// Panics if called before `init` finishes successfully
     pub fn token(&self) -> PathToken {
-        self.token.get().expect("path token not set")
+        (*self.token.lock()).expect("path token not set")
     }
 }
 
@@ -51,7 +61,7 @@ impl<W: ComponentWorld> SubActivity<W> for GoToSubActivity {
 
         // assign path
         let token = follow_path.new_path_with_goal(self.target, self.goal, self.speed);
-        self.token.set(Some(token));
+        *self.token.lock() = Some(token);
 
         // await arrival
         ctx.subscribe_to(
@@ -66,7 +76,7 @@ impl<W: ComponentWorld> SubActivity<W> for GoToSubActivity {
         // TODO helper on ctx to get component
 
         if let Ok(comp) = ctx.world.component_mut::<FollowPathComponent>(ctx.entity) {
-            let token = self.token.get();
+            let token = *self.token.lock();
             if token.is_some() && comp.current_token() == token {
                 comp.clear_path();
             }
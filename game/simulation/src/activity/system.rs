@@ -12,6 +12,7 @@ use crate::activity::{EventUnblockResult, EventUnsubscribeResult};
 use crate::activity::activities::NopActivity;
 use crate::activity::event_logging::EntityLoggingComponent;
 use crate::job::{SocietyJobRef, SocietyTask, SocietyTaskResult};
+use crate::scheduler::EntityTickScheduler;
 use crate::simulation::Tick;
 use crate::{Societies, SocietyComponent};
 use std::convert::TryFrom;
@@ -43,9 +44,11 @@ impl<'a> System<'a> for ActivitySystem {
         Read<'a, EntitiesRes>,
         Read<'a, EcsWorldFrameRef>,
         Read<'a, QueuedUpdates>,
+        Read<'a, FrameAllocator>,
         Read<'a, LazyUpdate>,
         Write<'a, Societies>,
         Write<'a, EntityEventQueue>,
+        Write<'a, EntityTickScheduler>,
     );
 
     fn run(
@@ -58,12 +61,15 @@ impl<'a> System<'a> for ActivitySystem {
             entities,
             world,
             updates,
+            allocator,
             comp_updates,
             mut societies,
             mut event_queue,
+            mut scheduler,
         ): Self::SystemData,
     ) {
-        let mut subscriptions = Vec::new(); // TODO reuse allocation in system
+        let frame = allocator.frame();
+        let mut subscriptions = FrameVec::new_in(&frame);
         for (entity, ai, activity, _) in (&entities, &mut ai, &mut activities, !&blocking).join() {
             log_scope!(o!("system" => "activity", E(entity)));
             debug!("current activity"; "activity" => &activity.current);
@@ -134,7 +140,9 @@ impl<'a> System<'a> for ActivitySystem {
                     event_queue.unsubscribe_all(entity);
                     comp_updates.remove::<BlockingActivityComponent>(entity);
 
-                    // interrupt ai and unreserve society task
+                    // interrupt ai and unreserve society task. the entity needs a fresh
+                    // decision next tick rather than waiting for its scheduler bucket
+                    scheduler.mark_urgent(entity);
                     ai.interrupt_current_action(entity, None, || {
                         society
                             .get(entity)
@@ -175,14 +175,14 @@ fn search_local_area_with_cache(
             );
 
             let (_, search) = v.insert((max_radius, results));
-            search as &LocalAreaSearch
+            search
         }
 
         Entry::Occupied(e) => {
             let (cached_range, _) = e.get();
             if max_radius <= *cached_range {
                 // use the bigger range and filter
-                &e.into_mut().1
+                &mut e.into_mut().1
             } else {
                 // current range > cached range, do the search again and replace the smaller values
                 let (range, results_mut) = e.into_mut();
@@ -200,7 +200,7 @@ fn search_local_area_with_cache(
                 );
                 *range = max_radius;
 
-                results_mut as &LocalAreaSearch
+                results_mut
             }
         }
     };
@@ -209,9 +209,18 @@ fn search_local_area_with_cache(
     if search.is_empty() {
         0.0
     } else {
+        let max_count = max_count as usize;
+        if search.len() > max_count {
+            // spatial query order is arbitrary, partition so the closest max_count come
+            // first. order within them doesn't matter, the score below is a sum
+            search.select_nth_unstable_by_key(max_count - 1, |(_, _, dist, _)| {
+                OrderedFloat(*dist)
+            });
+        }
+
         search
             .iter()
-            .take(max_count as usize)
+            .take(max_count)
             .map(|(e, _, dist, c)| {
                 // scale distance to the max radius provided - closest=1, furthest=0
                 let scaled_dist = Proportion::with_value(*dist as u32, max_radius);
@@ -229,7 +238,7 @@ fn search_local_area_with_cache(
 fn search_local_area(
     self_position: WorldPosition,
     world: &EcsWorld,
-    shared_bb: &mut SharedBlackboard,
+    shared_bb: &SharedBlackboard,
     filter: &ItemFilter,
     max_radius: f32,
     output: &mut LocalAreaSearch,
@@ -274,10 +283,17 @@ fn search_local_area(
                 } else {
                     (item_area, self_area)
                 };
-                reachable = *shared_bb
-                    .area_link_cache
-                    .entry(cache_key)
-                    .or_insert_with(|| voxel_world.area_path_exists(self_area, item_area));
+                let cached = shared_bb.area_link_cache.lock().get(&cache_key).copied();
+                reachable = match cached {
+                    Some(linked) => linked,
+                    None => {
+                        // don't hold the lock during the path find, a rare duplicate
+                        // search is cheaper than blocking every other entity
+                        let linked = voxel_world.area_path_exists(self_area, item_area);
+                        shared_bb.area_link_cache.lock().insert(cache_key, linked);
+                        linked
+                    }
+                };
             }
 
             reachable.as_some((entity, pos, dist, condition.0.value()))
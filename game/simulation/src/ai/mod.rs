@@ -1,6 +1,7 @@
 use std::collections::HashMap;
 
 use common::*;
+use parking_lot::Mutex;
 pub use input::AiInput;
 pub use system::{AiComponent, AiSystem};
 use unit::world::{WorldPoint, WorldPosition};
@@ -44,11 +45,13 @@ pub struct AiBlackboard<'a> {
 
     // For fetching other components
     pub world: &'a EcsWorld,
-    pub shared: &'a mut SharedBlackboard,
+    pub shared: &'a SharedBlackboard,
 }
 
+/// Read-only during scoring so entities can be scored in parallel, caches are behind
+/// locks
 pub struct SharedBlackboard {
-    pub area_link_cache: HashMap<(WorldArea, WorldArea), bool>,
+    pub area_link_cache: Mutex<HashMap<(WorldArea, WorldArea), bool>>,
 }
 
 impl ai::Blackboard for AiBlackboard<'_> {
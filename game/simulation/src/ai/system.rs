@@ -3,6 +3,8 @@ use std::iter::once;
 
 use ai::{AiBox, DecisionSource, Dse, Intelligence, IntelligentDecision};
 use common::*;
+use parking_lot::Mutex;
+use rayon::iter::ParallelIterator;
 
 use crate::activity::ActivityComponent;
 use crate::ai::dse::{dog_dses, human_dses, AdditionalDse, ObeyDivineCommandDse};
@@ -11,11 +13,12 @@ use crate::ecs::*;
 use crate::item::InventoryComponent;
 use crate::needs::HungerComponent;
 use crate::simulation::Tick;
-use crate::society::job::SocietyTask;
-use crate::society::{Society, SocietyComponent};
+use crate::society::job::{ReservationCount, SocietyTask};
+use crate::society::{Society, SocietyComponent, SocietyHandle};
 use crate::{EntityLoggingComponent, TransformComponent};
 
 use crate::job::JobIndex;
+use crate::scheduler::EntityTickScheduler;
 use crate::{dse, Societies};
 
 #[derive(Component, EcsComponent)]
@@ -24,6 +27,14 @@ use crate::{dse, Societies};
 pub struct AiComponent {
     intelligence: ai::Intelligence<AiContext>,
     current: Option<DecisionSource<AiContext>>,
+
+    /// Last society task filter result, reused while the society's job list generation is
+    /// unchanged
+    society_task_cache: Option<(
+        SocietyHandle,
+        u64,
+        Vec<(SocietyTask, JobIndex, ReservationCount)>,
+    )>,
 }
 
 impl AiComponent {
@@ -36,6 +47,7 @@ impl AiComponent {
         Self {
             intelligence,
             current: None,
+            society_task_cache: None,
         }
     }
 
@@ -89,6 +101,7 @@ impl<'a> System<'a> for AiSystem {
         Read<'a, EntitiesRes>,
         Read<'a, EcsWorldFrameRef>,
         Write<'a, Societies>,
+        Write<'a, EntityTickScheduler>,
         ReadStorage<'a, TransformComponent>,
         ReadStorage<'a, HungerComponent>,    // optional
         ReadStorage<'a, InventoryComponent>, // optional
@@ -104,6 +117,7 @@ impl<'a> System<'a> for AiSystem {
             entities,
             ecs_world,
             mut societies,
+            mut scheduler,
             transform,
             hunger,
             inventory,
@@ -113,114 +127,159 @@ impl<'a> System<'a> for AiSystem {
             mut logging,
         ): Self::SystemData,
     ) {
-        // TODO only run occasionally - FIXME TERRIBLE HACK
+        // only process the entities whose bucket is due this tick
         let tick = Tick::fetch();
-        if tick.value() % 10 != 0 {
-            return;
-        }
 
         let ecs_world: &EcsWorld = &*ecs_world;
         let societies: &mut Societies = &mut *societies;
+        let scheduler: &mut EntityTickScheduler = &mut *scheduler;
 
-        let mut shared_bb = SharedBlackboard {
-            area_link_cache: HashMap::new(),
+        let shared_bb = SharedBlackboard {
+            area_link_cache: Mutex::new(HashMap::new()),
         };
 
-        for (e, transform, hunger_opt, inventory_opt, ai, activity, society_opt) in (
+        // collect extra actions from society job lists up front, as filtering applicable
+        // tasks and pinning job indices needs mutable access to each society
+        // TODO provide READ ONLY DSEs to ai intelligence
+        // TODO use dynstack to avoid so many small temporary allocations, or arena allocator
+        // TODO fix eventually false assumption that all stream DSEs come from a society
+        let mut society_dses = HashMap::new();
+        for (e, _, ai, _, society_opt) in
+            (&entities, &transform, &mut ai, &activity, society.maybe()).join()
+        {
+            if !scheduler.is_due(e, tick) {
+                continue;
+            }
+
+            let society_opt: Option<&SocietyComponent> = society_opt; // for IDE
+            let mut society = society_opt.and_then(|comp| comp.resolve(societies));
+            let extra_dses = self.collect_society_tasks(e, ai, tick, society.as_mut(), ecs_world);
+            if !extra_dses.is_empty() {
+                society_dses.insert(e, extra_dses);
+            }
+        }
+
+        // score entities concurrently against the immutable world snapshot, collecting
+        // chosen actions to apply serially afterwards. component writes are disjoint
+        // through the parallel join, and the shared blackboard is only read
+        let new_decisions = Mutex::new(Vec::new());
+        let scheduler_ref: &EntityTickScheduler = scheduler;
+        (
             &entities,
             &transform,
             hunger.maybe(),
             inventory.maybe(),
             &mut ai,
-            &mut activity,
-            society.maybe(),
+            &activity,
         )
-            .join()
-        {
-            log_scope!(o!("system" => "ai", E(e)));
-            let society_opt: Option<&SocietyComponent> = society_opt; // for IDE
+            .par_join()
+            .for_each(|(e, transform, hunger_opt, inventory_opt, ai, _)| {
+                if !scheduler_ref.is_due(e, tick) {
+                    return;
+                }
 
-            // initialize blackboard
-            // TODO use arena/bump allocator and share instance between entities
-            let mut bb = AiBlackboard {
-                entity: e,
-                accessible_position: transform.accessible_position(),
-                position: transform.position,
-                hunger: hunger_opt.map(|h| h.hunger()),
-                inventory_search_cache: HashMap::new(),
-                local_area_search_cache: HashMap::new(),
-                inventory: inventory_opt,
-                world: ecs_world,
-                shared: &mut shared_bb,
-            };
+                log_scope!(o!("system" => "ai", E(e)));
+
+                // initialize blackboard
+                // TODO use arena/bump allocator and share instance between entities
+                let mut bb = AiBlackboard {
+                    entity: e,
+                    accessible_position: transform.accessible_position(),
+                    position: transform.position,
+                    hunger: hunger_opt.map(|h| h.hunger()),
+                    inventory_search_cache: HashMap::new(),
+                    local_area_search_cache: HashMap::new(),
+                    inventory: inventory_opt,
+                    world: ecs_world,
+                    shared: &shared_bb,
+                };
 
-            // safety: can't use true lifetime on Blackboard so using 'static and transmuting until
-            // we get our GATs
-            let bb_ref: &'a mut AiBlackboard = unsafe { std::mem::transmute(&mut bb) };
+                // safety: can't use true lifetime on Blackboard so using 'static and
+                // transmuting until we get our GATs
+                let bb_ref: &mut AiBlackboard = unsafe { std::mem::transmute(&mut bb) };
 
-            // collect extra actions from society job list, if any
-            // TODO provide READ ONLY DSEs to ai intelligence
-            // TODO use dynstack to avoid so many small temporary allocations, or arena allocator
-            // TODO fix eventually false assumption that all stream DSEs come from a society
-            let mut society = society_opt.and_then(|comp| comp.resolve(societies));
-            let extra_dses = self.collect_society_tasks(e, tick, society.as_mut(), ecs_world);
-
-            // choose best action
-            let streamed_dse = extra_dses.iter().map(|(_, _, dse)| &**dse);
-            let decision = ai
-                .intelligence
-                .choose_with_stream_dses(bb_ref, streamed_dse);
-
-            if let IntelligentDecision::New { dse, action, src } = decision {
-                debug!("new activity"; "dse" => dse.name(), "source" => ?src);
-                trace!("activity action"; "action" => ?action);
-
-                // register interruption
-                ai.interrupt_current_action(e, Some(&src), || {
-                    society
-                        .as_mut()
-                        .expect("streamed DSEs expected to come from a society only")
-                });
-
-                let society_task = if let DecisionSource::Stream(i) = src {
-                    // a society task was chosen, reserve it
-                    let society = society
-                        .as_mut()
-                        .expect("streamed DSEs expected to come from a society only");
-
-                    let (task, job_idx, _) = &extra_dses[i];
-                    let mut jobs = society.jobs_mut();
-
-                    // reserve task
-                    jobs.reservations_mut().reserve(task.clone(), e);
-
-                    // get job reference from index (avoiding the need to clone all job refs even
-                    // when not chosen)
-                    let job = jobs
-                        .by_index(*job_idx)
-                        .expect("jobs should not have changed");
-
-                    Some((job, task.clone()))
-                } else {
-                    None
-                };
+                let extra_dses = society_dses
+                    .get(&e)
+                    .map(|dses| dses.as_slice())
+                    .unwrap_or(&[]);
+
+                // choose best action
+                let streamed_dse = extra_dses.iter().map(|(_, _, dse)| &**dse);
+                let decision = ai
+                    .intelligence
+                    .choose_with_stream_dses(bb_ref, streamed_dse);
 
-                // log decision
-                if let Some(logs) = logging.get_mut(e) {
-                    logs.log_event(&action);
+                if let IntelligentDecision::New { dse, action, src } = decision {
+                    debug!("new activity"; "dse" => dse.name(), "source" => ?src);
+                    trace!("activity action"; "action" => ?action);
+
+                    new_decisions.lock().push((e, action, src));
                 }
+            });
+
+        // apply new decisions in entity order, so reservation conflicts resolve the same
+        // way regardless of which worker scored first
+        let mut new_decisions = new_decisions.into_inner();
+        new_decisions.sort_unstable_by_key(|(e, _, _)| *e);
 
-                ai.current = Some(src);
+        for (e, action, src) in new_decisions {
+            log_scope!(o!("system" => "ai", E(e)));
 
-                // pass on to activity system
-                activity.interrupt_with_new_activity(action, society_task, e, ecs_world);
+            let ai = ai.get_mut(e).expect("entity was just scored");
+            let mut society = society.get(e).and_then(|comp| comp.resolve(societies));
+
+            // register interruption
+            ai.interrupt_current_action(e, Some(&src), || {
+                society
+                    .as_mut()
+                    .expect("streamed DSEs expected to come from a society only")
+            });
+
+            let society_task = if let DecisionSource::Stream(i) = src {
+                // a society task was chosen, reserve it
+                let society = society
+                    .as_mut()
+                    .expect("streamed DSEs expected to come from a society only");
+
+                let extra_dses = &society_dses[&e];
+                let (task, job_idx, _) = &extra_dses[i];
+                let mut jobs = society.jobs_mut();
+
+                // reserve task
+                jobs.reservations_mut().reserve(task.clone(), e);
+
+                // get job reference from index (avoiding the need to clone all job refs even
+                // when not chosen)
+                let job = jobs
+                    .by_index(*job_idx)
+                    .expect("jobs should not have changed");
+
+                Some((job, task.clone()))
+            } else {
+                None
+            };
+
+            // log decision
+            if let Some(logs) = logging.get_mut(e) {
+                logs.log_event(&action);
             }
 
-            // job indices are finished with, allow modifications again
-            if let Some(society) = society {
+            ai.current = Some(src);
+
+            // pass on to activity system
+            let activity = activity.get_mut(e).expect("entity was just scored");
+            activity.interrupt_with_new_activity(action, society_task, e, ecs_world);
+        }
+
+        // job indices are finished with, allow modifications again
+        for (society_comp, _) in (&society, &ai).join() {
+            if let Some(society) = society_comp.resolve(societies) {
                 society.jobs_mut().allow_jobs_again();
             }
         }
+
+        // urgent entities have now had their early decision
+        scheduler.clear_urgent();
     }
 }
 
@@ -230,6 +289,7 @@ impl AiSystem {
     fn collect_society_tasks(
         &self,
         entity: Entity,
+        ai: &mut AiComponent,
         this_tick: Tick,
         society: Option<&mut &mut Society>,
         ecs_world: &EcsWorld,
@@ -239,16 +299,29 @@ impl AiSystem {
         if let Some(society) = society {
             trace!("considering tasks for society"; "society" => ?society);
 
-            let mut applicable_tasks = Vec::new(); // TODO reuse allocation
+            let handle = society.handle();
             let mut jobs = society.jobs_mut();
-            jobs.filter_applicable_tasks(entity, this_tick, ecs_world, &mut applicable_tasks);
+            jobs.refresh_if_needed(this_tick, ecs_world);
+
+            // reuse last filter result if nothing in the job list changed since
+            let generation = jobs.generation();
+            let cache_valid = matches!(&ai.society_task_cache,
+                Some((h, gen, _)) if *h == handle && *gen == generation);
+
+            if !cache_valid {
+                let mut applicable_tasks = Vec::new(); // TODO reuse allocation
+                jobs.filter_applicable_tasks(entity, this_tick, ecs_world, &mut applicable_tasks);
+                ai.society_task_cache = Some((handle, generation, applicable_tasks));
+            } else {
+                trace!("reusing cached applicable tasks"; "generation" => generation);
+            }
 
-            debug_assert!(
-                extra_dses.is_empty(),
-                "society tasks expected to be the only source of extra dses"
-            );
+            let (_, _, applicable_tasks) = ai
+                .society_task_cache
+                .as_ref()
+                .expect("task cache was just populated");
 
-            extra_dses.extend(applicable_tasks.into_iter().filter_map(
+            extra_dses.extend(applicable_tasks.iter().cloned().filter_map(
                 |(task, job_idx, reservations)| match task.as_dse(ecs_world, reservations) {
                     Some(dse) => Some((task, job_idx, dse)),
                     None => {
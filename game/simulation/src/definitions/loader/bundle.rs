@@ -0,0 +1,164 @@
+//! Precompiled definition bundles. After a successful load from ron sources the
+//! preprocessed definitions are serialized to a binary bundle next to them, and later
+//! startups deserialize that directly, skipping parsing and preprocessing entirely
+
+use std::fs::OpenOptions;
+use std::path::PathBuf;
+use std::time::UNIX_EPOCH;
+
+use serde::{Deserialize, Serialize};
+
+use common::*;
+use resources::{
+    recurse, ReadResource, ResourceContainer, ResourceError, ResourceErrorKind, ResourcePath,
+};
+
+use crate::definitions::loader::step1_deserialization::{
+    DefinitionSource, DeserializedDefinition,
+};
+use crate::definitions::loader::step2_preprocessing::ProcessedComponents;
+
+/// Bump when the bundled representation changes to invalidate old bundles
+const BUNDLE_VERSION: u32 = 1;
+
+/// Lives in the definitions directory itself, ignored by the ron file walk
+const BUNDLE_FILE: &str = "definitions.bundle";
+
+/// Snapshot of every definition after preprocessing, validated against the mtime and
+/// length of each source file. Parent inheritance crosses file boundaries, so any
+/// change to the sources invalidates the whole bundle rather than individual files
+#[derive(Serialize, Deserialize)]
+struct DefinitionBundle {
+    version: u32,
+    manifest: Vec<SourceStamp>,
+    definitions: Vec<BundledDefinition>,
+}
+
+#[derive(Serialize, Deserialize, Eq, PartialEq)]
+struct SourceStamp {
+    path: PathBuf,
+    /// Nanos since epoch of last modification, 0 if unavailable
+    mtime: u64,
+    len: u64,
+}
+
+#[derive(Serialize, Deserialize)]
+struct BundledDefinition {
+    uid: String,
+    is_abstract: bool,
+    source: PathBuf,
+    components: ProcessedComponents,
+}
+
+impl ReadResource for SourceStamp {
+    fn read_resource(path: impl AsRef<ResourcePath>) -> Result<Self, ResourceError> {
+        let path = path
+            .as_ref()
+            .file_path()
+            .expect("definition sources are on disk")
+            .to_owned();
+
+        let meta = std::fs::metadata(&path)
+            .map_err(|e| ResourceError(path.clone(), ResourceErrorKind::Io(e)))?;
+
+        let mtime = meta
+            .modified()
+            .ok()
+            .and_then(|t| t.duration_since(UNIX_EPOCH).ok())
+            .map(|d| d.as_nanos() as u64)
+            .unwrap_or(0);
+
+        let len = meta.len();
+        Ok(SourceStamp { path, mtime, len })
+    }
+}
+
+/// Loads preprocessed definitions from the bundle if it exists and no source file has
+/// been added, removed or modified since it was compiled. Ok(None) means no usable
+/// bundle, fall back to the sources
+pub fn try_load(
+    resources: &resources::Definitions,
+) -> BoxedResult<Option<Vec<DeserializedDefinition>>> {
+    let path = bundle_file(resources);
+    if !path.is_file() {
+        // not yet compiled
+        return Ok(None);
+    }
+
+    let file = OpenOptions::new().read(true).open(&path)?;
+    let bundle: DefinitionBundle = serde_cbor::from_reader(file)?;
+
+    if bundle.version != BUNDLE_VERSION {
+        debug!(
+            "ignoring definition bundle of old version {version}",
+            version = bundle.version
+        );
+        return Ok(None);
+    }
+
+    if collect_manifest(resources)? != bundle.manifest {
+        debug!("definition sources changed, ignoring stale bundle");
+        return Ok(None);
+    }
+
+    let defs = bundle
+        .definitions
+        .into_iter()
+        .map(|def| {
+            DeserializedDefinition::from_bundle(
+                def.uid,
+                def.is_abstract,
+                DefinitionSource::File(def.source.into()),
+                def.components,
+            )
+        })
+        .collect();
+
+    Ok(Some(defs))
+}
+
+/// Compiles the freshly preprocessed definitions into a bundle for the next startup
+pub fn save(
+    resources: &resources::Definitions,
+    defs: &[DeserializedDefinition],
+) -> BoxedResult<()> {
+    let bundle = DefinitionBundle {
+        version: BUNDLE_VERSION,
+        manifest: collect_manifest(resources)?,
+        definitions: defs
+            .iter()
+            .map(|def| BundledDefinition {
+                uid: def.uid().to_owned(),
+                is_abstract: def.is_abstract(),
+                source: match def.source() {
+                    DefinitionSource::File(path) => path.to_path_buf(),
+                    DefinitionSource::Memory => PathBuf::new(),
+                },
+                components: def.processed_components().clone(),
+            })
+            .collect(),
+    };
+
+    let path = bundle_file(resources);
+    info!("compiling definition bundle to {file}", file = path.display());
+
+    let file = OpenOptions::new()
+        .write(true)
+        .create(true)
+        .truncate(true)
+        .open(&path)?;
+    serde_cbor::to_writer(file, &bundle)?;
+
+    Ok(())
+}
+
+/// Stamps of all ron sources, sorted by path for comparison
+fn collect_manifest(resources: &resources::Definitions) -> BoxedResult<Vec<SourceStamp>> {
+    let mut manifest = recurse::<_, SourceStamp>(resources, "ron").collect::<Result<Vec<_>, _>>()?;
+    manifest.sort_unstable_by(|a, b| a.path.cmp(&b.path));
+    Ok(manifest)
+}
+
+fn bundle_file(resources: &resources::Definitions) -> PathBuf {
+    resources.path().join(BUNDLE_FILE)
+}
@@ -1,3 +1,6 @@
+use common::*;
+
+use crate::definitions::loader::bundle;
 use crate::definitions::loader::step1_deserialization::{
     collect_raw_definitions, DefinitionUid, DeserializedDefinition,
 };
@@ -8,7 +11,32 @@ use crate::definitions::registry::RegistryBuilder;
 use crate::definitions::{DefinitionError, DefinitionErrors, Registry};
 
 pub fn load(resources: resources::Definitions) -> Result<Registry, DefinitionErrors> {
-    let defs = load_and_preprocess_with(|| collect_raw_definitions(resources))?;
+    // try the precompiled bundle first, skipping parsing and preprocessing entirely
+    let defs = match bundle::try_load(&resources) {
+        Ok(Some(defs)) => {
+            info!(
+                "loaded {count} definitions from precompiled bundle",
+                count = defs.len()
+            );
+            defs
+        }
+        bundle_result => {
+            if let Err(e) = bundle_result {
+                warn!("failed to load definition bundle, falling back to sources"; "error" => %e);
+            }
+
+            let defs = load_and_preprocess_with(|| collect_raw_definitions(resources.clone()))?;
+
+            // compile a bundle for the next startup. not fatal on failure, next
+            // startup just parses the sources again
+            if let Err(e) = bundle::save(&resources, &defs) {
+                warn!("failed to compile definition bundle"; "error" => %e);
+            }
+
+            defs
+        }
+    };
+
     let instantiated = instantiate(defs, &TemplateLookup::init())?;
     build_registry(instantiated)
 }
@@ -7,6 +7,7 @@ pub type ValueImpl = ron::Value;
 #[cfg(test)]
 pub use load::load_from_str;
 
+mod bundle;
 mod helpers;
 mod load;
 mod step1_deserialization;
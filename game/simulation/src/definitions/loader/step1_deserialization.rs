@@ -2,7 +2,7 @@ use std::cell::{Ref, RefCell, RefMut};
 use std::fs::File;
 use std::ops::Deref;
 use std::path::Path;
-use std::rc::Rc;
+use std::sync::Arc;
 
 use serde::Deserialize;
 
@@ -40,7 +40,7 @@ pub struct DeserializedDefinition {
 
 #[derive(Debug, Clone)]
 pub enum DefinitionSource {
-    File(Rc<Path>),
+    File(Arc<Path>),
     Memory,
 }
 
@@ -112,6 +112,24 @@ impl DeserializedDefinition {
         self.processed_components.borrow_mut()
     }
 
+    /// Reconstruct from a precompiled bundle - parsing and preprocessing already
+    /// happened when the bundle was compiled, so the raw components are empty
+    pub fn from_bundle(
+        uid: DefinitionUid,
+        is_abstract: bool,
+        source: DefinitionSource,
+        components: ProcessedComponents,
+    ) -> Self {
+        Self {
+            uid,
+            parent: String::new(), // already flattened into components
+            r#abstract: is_abstract,
+            components: Components::default(),
+            processed_components: RefCell::new(components),
+            source,
+        }
+    }
+
     pub fn from_ron(bytes: &[u8], source: DefinitionSource) -> Result<Vec<Self>, DefinitionError> {
         ron::de::from_bytes(bytes)
             .map(|mut vec: Vec<DeserializedDefinition>| {
@@ -139,7 +157,7 @@ pub fn collect_raw_definitions(
     let mut errors = Vec::new();
 
     // collect unprocessed definitions
-    for file in resources::recurse::<_, (File, resources::Mmap, Rc<Path>)>(&resources, "ron") {
+    for file in resources::recurse::<_, (File, resources::Mmap, Arc<Path>)>(&resources, "ron") {
         // handle resource error
         let file = file.map_err(|ResourceError(path, e)| {
             DefinitionError(
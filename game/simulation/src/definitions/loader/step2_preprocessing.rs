@@ -5,6 +5,7 @@ use daggy::petgraph::visit::{EdgeRef, IntoEdgesDirected};
 use daggy::petgraph::Direction;
 use daggy::{Dag, Walker};
 use serde::de::Error;
+use serde::{Deserialize, Serialize};
 
 use common::derive_more::IntoIterator;
 use common::*;
@@ -13,13 +14,13 @@ use crate::definitions::loader::helpers::{extract_map, extract_string_ref};
 use crate::definitions::loader::step1_deserialization::{Components, DeserializedDefinition};
 use crate::definitions::{DefinitionErrorKind, DefinitionErrors};
 
-#[derive(Debug, Clone, Default, IntoIterator)]
+#[derive(Debug, Clone, Default, IntoIterator, Serialize, Deserialize)]
 pub struct ProcessedComponents(Vec<(String, ComponentFields)>);
 
 #[derive(Debug, Clone, Default)]
 pub struct Fields(Vec<(String, ron::Value)>);
 
-#[derive(Debug, Clone)]
+#[derive(Debug, Clone, Serialize, Deserialize)]
 pub enum ComponentFields {
     Fields(Vec<(String, ron::Value)>),
     Unit,
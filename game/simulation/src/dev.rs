@@ -175,7 +175,7 @@ impl EcsExtDev<'_> {
         &mut self,
         wat: &'static str,
         container_pos: WorldPosition,
-        mut f: impl FnMut(&mut EcsWorld, Entity) + 'static,
+        mut f: impl FnMut(&mut EcsWorld, Entity) + Send + 'static,
     ) {
         self.resource::<QueuedUpdates>().queue(wat, move |world| {
             let w = world.voxel_world();
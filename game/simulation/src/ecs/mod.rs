@@ -1,9 +1,9 @@
 use std::collections::HashMap;
 
 pub use specs::{
-    world::EntitiesRes, Builder, Component, DenseVecStorage, Entity, EntityBuilder, HashMapStorage,
-    Join, LazyUpdate, NullStorage, Read, ReadExpect, ReadStorage, RunNow, System, SystemData,
-    VecStorage, WorldExt, Write, WriteExpect, WriteStorage,
+    world::EntitiesRes, Builder, Component, DenseVecStorage, Dispatcher, DispatcherBuilder,
+    Entity, EntityBuilder, HashMapStorage, Join, LazyUpdate, NullStorage, ParJoin, Read, ReadExpect,
+    ReadStorage, RunNow, System, SystemData, VecStorage, WorldExt, Write, WriteExpect, WriteStorage,
 };
 pub use specs_derive::Component;
 
@@ -14,7 +14,9 @@ pub use template::{ComponentTemplate, ComponentTemplateEntry, ValueImpl};
 
 pub use crate::register_component_template;
 
-pub use self::world::{ComponentGetError, ComponentWorld, EcsWorld, EcsWorldFrameRef};
+pub use self::world::{
+    ComponentGetError, ComponentWorld, EcsWorld, EcsWorldFrameRef, FrameAllocator, FrameVec,
+};
 pub type SpecsWorld = specs::World;
 
 mod component;
@@ -2,7 +2,7 @@ pub use crate::definitions::ValueImpl;
 use crate::ecs::*;
 use common::Debug;
 
-pub trait ComponentTemplate<V: Value>: Debug {
+pub trait ComponentTemplate<V: Value>: Debug + Send + Sync {
     fn construct(values: &mut Map<V>) -> Result<Box<dyn ComponentTemplate<V>>, ComponentBuildError>
     where
         Self: Sized;
@@ -21,6 +21,42 @@ pub struct EcsWorld {
 /// World reference for the current frame only - very unsafe, don't store!
 pub struct EcsWorldFrameRef(&'static EcsWorld);
 
+/// Scratch vector backed by the per-tick [FrameAllocator] arena
+pub type FrameVec<'frame, T> = bumpalo::collections::Vec<'frame, T>;
+
+/// Bump arena for per-tick scratch allocations, reset at the start of every tick before
+/// any system runs. Nothing allocated from it can outlive the tick, so per-tick
+/// temporaries don't hit the global allocator at all
+pub struct FrameAllocator(parking_lot::Mutex<bumpalo::Bump>);
+
+impl Default for FrameAllocator {
+    fn default() -> Self {
+        // enough for a typical tick without growing
+        Self(parking_lot::Mutex::new(bumpalo::Bump::with_capacity(
+            64 * 1024,
+        )))
+    }
+}
+
+impl FrameAllocator {
+    /// Locks the arena for the duration of a system run - take it once per run and
+    /// allocate through it with e.g. [FrameVec::new_in], not once per allocation
+    pub fn frame(&self) -> parking_lot::MutexGuard<bumpalo::Bump> {
+        self.0.lock()
+    }
+
+    /// Frees everything allocated this tick in a single cheap operation, keeping the
+    /// backing chunks for reuse next tick
+    pub fn reset(&mut self) {
+        self.0.get_mut().reset()
+    }
+}
+
+// safety: resource access through the frame ref is runtime borrow-checked by shred, and the
+// world itself outlives the tick this ref is valid for
+unsafe impl Send for EcsWorldFrameRef {}
+unsafe impl Sync for EcsWorldFrameRef {}
+
 #[macro_export]
 macro_rules! entity_pretty {
     ($e:expr) => {
@@ -51,9 +87,9 @@ pub trait ComponentWorld: ContainerResolver + Sized {
     fn add_now<T: Component>(&mut self, entity: Entity, component: T) -> InsertResult<T>;
     fn remove_now<T: Component>(&mut self, entity: Entity) -> Option<T>;
 
-    fn add_lazy<T: Component>(&self, entity: Entity, component: T);
+    fn add_lazy<T: Component + Send + Sync>(&self, entity: Entity, component: T);
 
-    fn remove_lazy<T: Component>(&self, entity: Entity);
+    fn remove_lazy<T: Component + Send + Sync>(&self, entity: Entity);
 
     fn voxel_world(&self) -> WorldRef;
 
@@ -179,12 +215,12 @@ impl ComponentWorld for EcsWorld {
     }
 
     // TODO specs lazy updates allocs a Box for each action - when our QueuedUpdates uses an arena swap this out to use that instead
-    fn add_lazy<T: Component>(&self, entity: Entity, component: T) {
+    fn add_lazy<T: Component + Send + Sync>(&self, entity: Entity, component: T) {
         let lazy = self.read_resource::<LazyUpdate>();
         lazy.insert(entity, component);
     }
 
-    fn remove_lazy<T: Component>(&self, entity: Entity) {
+    fn remove_lazy<T: Component + Send + Sync>(&self, entity: Entity) {
         let lazy = self.read_resource::<LazyUpdate>();
         lazy.remove::<T>(entity);
     }
@@ -15,9 +15,17 @@ pub struct EntityEventQueue {
     events: Vec<EntityEvent>,
     unsubscribers: HashMap<Entity, Option<EntityEventSubscription>>,
 
-    /// subject -> interested subscriber and his subscriptions
+    /// subject -> interested subscriber and his subscriptions, the per-type level of the
+    /// index being the bitset of event types
     subscriptions: HashMap<Entity, SmallVec<[(Entity, BitSet); 2]>>,
-    needs_cleanup: u32,
+
+    /// subscriber -> subjects he is subscribed to, the reverse of [subscriptions] so
+    /// unsubscribing only touches his own entries
+    subjects: HashMap<Entity, SmallVec<[Entity; 2]>>,
+
+    /// subscriber -> indices into [events], batching up each subscriber's events for the
+    /// tick. allocations are reused between ticks
+    batches: HashMap<Entity, Vec<usize>>,
 }
 
 impl Default for EntityEventQueue {
@@ -26,7 +34,8 @@ impl Default for EntityEventQueue {
             events: Vec::with_capacity(512),
             unsubscribers: HashMap::with_capacity(64),
             subscriptions: HashMap::with_capacity(64),
-            needs_cleanup: 0,
+            subjects: HashMap::with_capacity(64),
+            batches: HashMap::with_capacity(64),
         }
     }
 }
@@ -50,16 +59,22 @@ impl EntityEventQueue {
 
                         if let Some((_, bitset)) = existing {
                             bitset.add_all(subscriptions);
-                        } else {
-                            let bitset = BitSet::with(subscriptions);
-                            subs.push((subscriber, bitset));
+
+                            // reverse index already has this pair
+                            return;
                         }
+
+                        let bitset = BitSet::with(subscriptions);
+                        subs.push((subscriber, bitset));
                     }
                     Entry::Vacant(e) => {
                         let bitset = BitSet::with(subscriptions);
                         e.insert(smallvec![(subscriber, bitset)]);
                     }
                 };
+
+                // register new pair in reverse index
+                self.subjects.entry(subscriber).or_default().push(subject);
             });
     }
 
@@ -69,50 +84,59 @@ impl EntityEventQueue {
     }
 
     pub fn unsubscribe_all(&mut self, subscriber: Entity) {
-        let mut removals = 0;
-        self.subscriptions
-            .values_mut()
-            .flat_map(|subs| subs.iter_mut())
-            .filter(|(interested, _)| *interested == subscriber)
-            .for_each(|(_, bitset)| {
-                bitset.clear();
-                removals += 1;
-            });
+        // visit only this subscriber's subjects via the reverse index, instead of
+        // scanning every subscription list
+        let subjects = match self.subjects.remove(&subscriber) {
+            Some(subjects) => subjects,
+            None => return, // never subscribed
+        };
+
+        for subject in subjects.iter() {
+            if let Entry::Occupied(mut e) = self.subscriptions.entry(*subject) {
+                let subs = e.get_mut();
+                if let Some(idx) = subs.iter().position(|(e, _)| *e == subscriber) {
+                    subs.swap_remove(idx);
+                }
+                if subs.is_empty() {
+                    e.remove();
+                }
+            }
+        }
 
         trace!(
             "unsubscribed {subscriber} from {count}",
             subscriber = E(subscriber),
-            count = removals
+            count = subjects.len()
         );
-        self.needs_cleanup += removals;
     }
 
     pub fn unsubscribe(&mut self, subscriber: Entity, unsubscription: EntityEventSubscription) {
         let EntityEventSubscription(subject, sub) = unsubscription;
-        if let Some(subs) = self.subscriptions.get_mut(&subject) {
+        if let Entry::Occupied(mut e) = self.subscriptions.entry(subject) {
+            let subs = e.get_mut();
             if let Some(idx) = subs.iter().position(|(e, _)| *e == subscriber) {
                 let (_, bitset) = unsafe { subs.get_unchecked_mut(idx) };
                 if bitset.remove(sub) {
-                    self.needs_cleanup += 1;
+                    // last subscription to this subject, remove from both indices
+                    subs.swap_remove(idx);
+                    if subs.is_empty() {
+                        e.remove();
+                    }
+
+                    if let Some(subjects) = self.subjects.get_mut(&subscriber) {
+                        if let Some(idx) = subjects.iter().position(|e| *e == subject) {
+                            subjects.swap_remove(idx);
+                        }
+                    }
                 }
             }
         }
     }
 
-    fn maintain(&mut self) {
-        // TODO track by game tick instead of just number of ops
-        if self.needs_cleanup > 500 {
-            self.needs_cleanup = 0;
-            self.subscriptions.retain(|_, subs| {
-                subs.retain(|(_, bitset)| !bitset.is_empty());
-                !subs.is_empty()
-            });
-        }
-    }
-
     /// Consumes all events posted since the last call.
     ///
-    /// * f: called per subscribed entity, f(subscriber, event)
+    /// * f: called per subscribed entity, f(subscriber, event). each subscriber gets all
+    ///   his events consecutively, in posting order
     /// * all_events: called with all events regardless of subscriptions
     pub fn consume_events(
         &mut self,
@@ -121,7 +145,10 @@ impl EntityEventQueue {
     ) {
         all_events(&self.events);
 
-        let grouped_events = self.events.iter().group_by(|evt| evt.subject);
+        // batch up this tick's events per subscriber, one subject lookup per run of events.
+        // need to swap map out from self to be able to access self immutably
+        let mut batches = std::mem::take(&mut self.batches);
+        let grouped_events = self.events.iter().enumerate().group_by(|(_, evt)| evt.subject);
 
         for (subject, events) in grouped_events.into_iter() {
             // find subscribers interested in this subject entity
@@ -141,41 +168,60 @@ impl EntityEventQueue {
                 }
             };
 
-            // pass events to subscriptions
-            for event in events {
+            for (idx, event) in events {
                 for subscriber in subscribers.iter().filter_map(|(subscriber, sub)| {
                     sub.contains(&event.payload).as_some(subscriber)
                 }) {
-                    let is_unsubscribed_already = self
-                        .unsubscribers
-                        .get(subscriber)
-                        .map(|unsub| match unsub {
-                            None => true, // unsub from all
-                            Some(sub) => sub.matches(event),
-                        })
-                        .unwrap_or(false);
-
-                    if is_unsubscribed_already {
-                        // already unsubscribed, no more events pls
-                        trace!("already unsubscribed, skipping"; "subscriber" => E(*subscriber), "event" => ?event);
-                        continue;
+                    batches.entry(*subscriber).or_default().push(idx);
+                }
+            }
+        }
+
+        // pass each subscriber his events consecutively, in posting order
+        for (subscriber, batch) in batches.iter() {
+            let subscriber = *subscriber;
+            let mut unsubscription = None;
+
+            for event in batch.iter().map(|idx| &self.events[*idx]) {
+                let is_unsubscribed_already = match &unsubscription {
+                    Some(None) => true, // unsub from all
+                    Some(Some(sub)) => {
+                        let sub: &EntityEventSubscription = sub; // for IDE
+                        sub.matches(event)
                     }
+                    None => false,
+                };
 
-                    debug!("passing event"; "subscriber" => E(*subscriber), "event" => ?event);
-                    let result = f(*subscriber, event);
-                    trace!("result"; "result" => ?result, "subscriber" => E(*subscriber), "event" => ?event);
+                if is_unsubscribed_already {
+                    // already unsubscribed, no more events pls
+                    trace!("already unsubscribed, skipping"; "subscriber" => E(subscriber), "event" => ?event);
+                    continue;
+                }
 
-                    let unsubscription = match result {
-                        EventUnsubscribeResult::UnsubscribeAll => None,
-                        EventUnsubscribeResult::Unsubscribe(subs) => Some(subs),
-                        EventUnsubscribeResult::StaySubscribed => continue,
-                    };
+                debug!("passing event"; "subscriber" => E(subscriber), "event" => ?event);
+                let result = f(subscriber, event);
+                trace!("result"; "result" => ?result, "subscriber" => E(subscriber), "event" => ?event);
 
-                    self.unsubscribers.insert(*subscriber, unsubscription);
-                }
+                unsubscription = match result {
+                    EventUnsubscribeResult::UnsubscribeAll => Some(None),
+                    EventUnsubscribeResult::Unsubscribe(subs) => Some(Some(subs)),
+                    EventUnsubscribeResult::StaySubscribed => continue,
+                };
+            }
+
+            if let Some(unsubscription) = unsubscription {
+                self.unsubscribers.insert(subscriber, unsubscription);
             }
         }
 
+        // reuse batch allocations of subscribers still active next tick
+        batches.retain(|_, batch| {
+            let used = !batch.is_empty();
+            batch.clear();
+            used
+        });
+        std::mem::swap(&mut batches, &mut self.batches);
+
         // handle unsubscriptions
         // need to swap vec out from self to be able to access self mutably
         let mut unsubs = std::mem::take(&mut self.unsubscribers);
@@ -203,8 +249,6 @@ impl EntityEventQueue {
         std::mem::forget(unsubs);
 
         self.events.clear();
-
-        self.maintain()
     }
 
     pub fn log(&self) {
@@ -579,6 +623,49 @@ mod tests {
         assert_eq!(subs, vec![EntityEventType::DummyB]);
     }
 
+    #[test]
+    fn batched_per_subscriber() {
+        let mut q = EntityEventQueue::default();
+        let (e1, e2) = make_entities();
+
+        // subscribe to both subjects
+        q.subscribe(
+            e1,
+            once(EntityEventSubscription(e1, EventSubscription::All)),
+        );
+        q.subscribe(
+            e1,
+            once(EntityEventSubscription(e2, EventSubscription::All)),
+        );
+
+        // interleave subjects
+        q.post(EntityEvent {
+            subject: e1,
+            payload: EntityEventPayload::DummyA,
+        });
+        q.post(EntityEvent {
+            subject: e2,
+            payload: EntityEventPayload::DummyA,
+        });
+        q.post(EntityEvent {
+            subject: e1,
+            payload: EntityEventPayload::DummyB,
+        });
+
+        let mut subjects = Vec::with_capacity(3);
+        q.consume_events(
+            |sub, e| {
+                assert_eq!(sub, e1);
+                subjects.push(e.subject);
+                EventUnsubscribeResult::StaySubscribed
+            },
+            |_| {},
+        );
+
+        // delivered in posting order despite interleaved subjects
+        assert_eq!(subjects, vec![e1, e2, e1]);
+    }
+
     #[test]
     fn multiple_subscribers() {
         // logging::for_tests();
@@ -5,7 +5,7 @@ pub use world::{
     block::{BlockType, IntoEnumIterator},
     loader::{
         AsyncWorkerPool, BlockForAllError, GeneratedTerrainSource, PlanetParams,
-        TerrainSourceError, TerrainUpdatesRes, WorldLoader, WorldTerrainUpdate,
+        TerrainSourceError, TerrainUpdatesRes, WorkerHandle, WorldLoader, WorldTerrainUpdate,
     },
     presets, BaseVertex, SliceRange,
 };
@@ -58,6 +58,7 @@ mod perf;
 mod physics;
 mod queued_update;
 mod render;
+mod scheduler;
 mod scripting;
 mod senses;
 mod simulation;
@@ -66,3 +67,13 @@ mod spatial;
 mod steer;
 mod transform;
 mod world_debug;
+
+#[cfg(feature = "benchmarking")]
+pub mod benchmark_exports {
+    pub use crate::activity::EventUnsubscribeResult;
+    pub use crate::event::{
+        EntityEvent, EntityEventPayload, EntityEventQueue, EntityEventSubscription,
+        EventSubscription,
+    };
+    pub use crate::spatial::{Spatial, SpatialSystem};
+}
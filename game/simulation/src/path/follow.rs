@@ -1,8 +1,10 @@
+use std::sync::Arc;
+
 use crate::path::PathToken;
 use common::NormalizedFloat;
 use common::*;
 use unit::world::{WorldPoint, WorldPosition};
-use world::{EdgeCost, SearchGoal, WorldPath};
+use world::{EdgeCost, FlowField, SearchGoal, WorldPath};
 
 #[derive(Debug)]
 pub enum PathRequest {
@@ -13,6 +15,12 @@ pub enum PathRequest {
         speed: NormalizedFloat,
         token: PathToken,
     },
+    /// Follow a shared flow field instead of a private path
+    FlowField {
+        field: Arc<FlowField>,
+        speed: NormalizedFloat,
+        token: PathToken,
+    },
     ClearCurrent,
 }
 pub struct PathFollowing {
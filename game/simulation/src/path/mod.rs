@@ -1,5 +1,8 @@
 pub use debug::{NavigationAreaDebugRenderer, PathDebugRenderer};
-pub use system::{FollowPathComponent, PathSteeringSystem, PathToken};
+pub use system::{
+    FollowPathComponent, PathRequestsRes, PathResultsRes, PathSteeringSystem, PathToken,
+    QueuedPathSearch,
+};
 
 mod debug;
 mod follow;
@@ -1,14 +1,15 @@
 use std::iter::once;
+use std::sync::Arc;
 
 use common::*;
-use unit::world::WorldPoint;
-use world::{NavigationError, SearchGoal};
+use unit::world::{WorldPoint, WorldPosition};
+use world::{FlowField, NavigationError, SearchGoal, WorldPath};
 
 use crate::ecs::*;
 use crate::event::{EntityEvent, EntityEventPayload, EntityEventQueue};
 use crate::path::follow::{PathFollowing, PathRequest};
 use crate::steer::{SteeringBehaviour, SteeringComponent};
-use crate::{TransformComponent, WorldRef};
+use crate::TransformComponent;
 
 /// Holds the current path to follow
 #[derive(Component, EcsComponent)]
@@ -16,11 +17,18 @@ use crate::{TransformComponent, WorldRef};
 #[name("path")]
 pub struct FollowPathComponent {
     path: Option<PathFollowing>,
+
+    /// Shared flow field to follow instead of a private path, looked up by current
+    /// position each step
+    flow: Option<Arc<FlowField>>,
     follow_speed: NormalizedFloat,
     current_token: Option<PathToken>,
 
-    /// If set, will be popped in next tick and `path` updated
+    /// If set, will be popped in next tick and submitted to the async path service
     request: Option<PathRequest>,
+
+    /// Search submitted to the async path service, awaiting its result
+    pending: Option<PendingPath>,
     next_token: u64,
 }
 
@@ -28,13 +36,41 @@ pub struct FollowPathComponent {
 #[derive(Eq, PartialEq, Copy, Clone)]
 pub struct PathToken(u64);
 
-/// System to assign steering behaviour from current path, if any
+struct PendingPath {
+    token: PathToken,
+    target: WorldPoint,
+    goal: SearchGoal,
+    speed: NormalizedFloat,
+}
+
+/// A search queued by [PathSteeringSystem], drained by the main loop each tick and
+/// submitted to the world loader's async path service as a single batch
+pub struct QueuedPathSearch {
+    pub entity: Entity,
+    pub from: WorldPosition,
+    pub to: WorldPosition,
+    pub goal: SearchGoal,
+    pub token: PathToken,
+}
+
+/// Ecs resource holding this tick's queued async path searches
+#[derive(Default)]
+pub struct PathRequestsRes(pub Vec<QueuedPathSearch>);
+
+/// Ecs resource holding completed async path searches, consumed by [PathSteeringSystem]
+#[derive(Default)]
+pub struct PathResultsRes(pub Vec<(Entity, PathToken, Result<WorldPath, NavigationError>)>);
+
+/// System to assign steering behaviour from current path, if any. Path searches
+/// themselves run asynchronously on the world loader's worker pool, polled here on a
+/// later tick
 pub struct PathSteeringSystem;
 
 impl<'a> System<'a> for PathSteeringSystem {
     type SystemData = (
         Read<'a, EntitiesRes>,
-        Read<'a, WorldRef>,
+        Write<'a, PathRequestsRes>,
+        Write<'a, PathResultsRes>,
         Write<'a, EntityEventQueue>,
         WriteStorage<'a, TransformComponent>,
         WriteStorage<'a, FollowPathComponent>,
@@ -43,8 +79,48 @@ impl<'a> System<'a> for PathSteeringSystem {
 
     fn run(
         &mut self,
-        (entities, world, mut event_queue, mut transform, mut path, mut steer): Self::SystemData,
+        (entities, mut requests, mut results, mut event_queue, mut transform, mut path, mut steer): Self::SystemData,
     ) {
+        // assign paths found by the async path service since last tick
+        for (e, token, result) in results.0.drain(..) {
+            let comp = match path.get_mut(e) {
+                Some(comp) => comp,
+                None => continue, // entity died or lost its component while searching
+            };
+
+            log_scope!(o!("system" => "path steering", E(e)));
+
+            let pending = match comp.pending.take() {
+                Some(pending) if pending.token == token => pending,
+                stale => {
+                    // search was aborted or replaced while in flight
+                    trace!("dropping stale path result"; "token" => ?token);
+                    comp.pending = stale;
+                    continue;
+                }
+            };
+
+            match result {
+                Err(err) => {
+                    warn!("failed to find path"; "target" => ?pending.target, "error" => %err);
+
+                    event_queue.post(EntityEvent {
+                        subject: e,
+                        payload: EntityEventPayload::Arrived(token, Err(err)),
+                    });
+                }
+                Ok(new_path) => {
+                    let path_len = new_path.path().len();
+                    let new_following = PathFollowing::new(new_path, pending.target, pending.goal);
+                    debug!("following new path"; "target" => ?new_following.target(), "path_nodes" => path_len);
+
+                    comp.path = Some(new_following);
+                    comp.follow_speed = pending.speed;
+                    comp.current_token = Some(token);
+                }
+            }
+        }
+
         for (e, transform, mut path, steer) in
             (&entities, &mut transform, &mut path, &mut steer).join()
         {
@@ -67,48 +143,107 @@ impl<'a> System<'a> for PathSteeringSystem {
                     });
                 }
 
+                // abort any in-flight search too, its result will be dropped as stale
+                if let Some(pending) = path.pending.take() {
+                    event_queue.post(EntityEvent {
+                        subject: e,
+                        payload: EntityEventPayload::Arrived(
+                            pending.token,
+                            Err(NavigationError::Aborted),
+                        ),
+                    });
+                }
+
                 // clobber current path
                 path.path = None;
+                path.flow = None;
                 path.current_token = None;
 
                 match req {
                     PathRequest::ClearCurrent => {
                         debug!("clearing current path by request");
                     }
+                    PathRequest::FlowField {
+                        field,
+                        speed,
+                        token,
+                    } => {
+                        // no search needed, directions are looked up as we go
+                        debug!("following shared flow field"; "field" => ?field);
+                        path.flow = Some(field);
+                        path.follow_speed = speed;
+                        path.current_token = Some(token);
+                    }
                     PathRequest::NewTarget {
                         target,
                         goal,
                         speed,
                         token,
                     } => {
-                        let world = (*world).borrow();
-                        let new_path = world.find_path_with_goal(
-                            transform.accessible_position(),
-                            target.floor(),
+                        // queue for the async path service and poll result on a later tick
+                        requests.0.push(QueuedPathSearch {
+                            entity: e,
+                            from: transform.accessible_position(),
+                            to: target.floor(),
                             goal,
-                        );
+                            token,
+                        });
+
+                        path.pending = Some(PendingPath {
+                            token,
+                            target,
+                            goal,
+                            speed,
+                        });
+                    }
+                }
+            }
+
+            // flow field following looks up the next step from the current block, so
+            // many followers share one field with no per-entity search
+            if let Some(field) = path.flow.clone() {
+                if steer.behaviour.is_nop() {
+                    let current = transform.accessible_position();
 
-                        match new_path {
-                            Err(err) => {
-                                warn!("failed to find path"; "target" => ?target, "error" => %err);
+                    if current == field.goal() {
+                        trace!("arrived at flow field goal"; "goal" => %field.goal());
 
+                        let token = path.current_token.take().expect("should have token");
+                        event_queue.post(EntityEvent {
+                            subject: e,
+                            payload: EntityEventPayload::Arrived(token, Ok(field.goal().centred())),
+                        });
+
+                        path.flow = None;
+                    } else {
+                        match field.direction_from(current) {
+                            Some((next_block, cost)) => {
+                                trace!("next flow field step"; "waypoint" => ?next_block, "cost" => ?cost);
+                                steer.behaviour = SteeringBehaviour::seek(
+                                    next_block.centred(),
+                                    path.follow_speed,
+                                );
+                            }
+                            None => {
+                                // strayed off the field's covered areas, can't recover
+                                warn!("lost the flow field"; "position" => %current, "field" => ?field);
+
+                                let token = path.current_token.take().expect("should have token");
                                 event_queue.post(EntityEvent {
                                     subject: e,
-                                    payload: EntityEventPayload::Arrived(token, Err(err)),
+                                    payload: EntityEventPayload::Arrived(
+                                        token,
+                                        Err(NavigationError::SourceNotWalkable(current)),
+                                    ),
                                 });
+
+                                path.flow = None;
                             }
-                            Ok(new_path) => {
-                                let path_len = new_path.path().len();
-                                let new_following = PathFollowing::new(new_path, target, goal);
-                                debug!("following new path"; "target" => ?new_following.target(), "path_nodes" => path_len);
-
-                                path.path = Some(new_following);
-                                path.follow_speed = speed;
-                                path.current_token = Some(token);
-                            }
-                        };
+                        }
                     }
                 }
+
+                continue;
             }
 
             let following = match path.path.as_mut() {
@@ -179,6 +314,21 @@ impl FollowPathComponent {
         token
     }
 
+    /// Follow a precomputed flow field shared with other entities heading for the same
+    /// goal, instead of requesting a private path search
+    pub fn follow_flow_field(&mut self, field: Arc<FlowField>, speed: NormalizedFloat) -> PathToken {
+        let token = PathToken(self.next_token);
+        self.next_token = self.next_token.wrapping_add(1);
+
+        self.set_request(PathRequest::FlowField {
+            field,
+            speed,
+            token,
+        });
+
+        token
+    }
+
     pub fn clear_path(&mut self) {
         self.set_request(PathRequest::ClearCurrent);
     }
@@ -210,7 +360,9 @@ impl Default for FollowPathComponent {
     fn default() -> Self {
         Self {
             path: None,
+            flow: None,
             request: None,
+            pending: None,
             follow_speed: NormalizedFloat::one(),
             next_token: 0x1000,
             current_token: None,
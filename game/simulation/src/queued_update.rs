@@ -1,4 +1,4 @@
-use std::cell::RefCell;
+use common::parking_lot::Mutex;
 
 use common::*;
 use unit::world::{WorldPosition, WorldPositionRange};
@@ -9,32 +9,33 @@ use world::BlockDamageResult;
 use crate::ecs::EcsWorld;
 use crate::ComponentWorld;
 
-type Update = dyn FnOnce(&mut EcsWorld) -> Result<(), Box<dyn Error>>;
+type Update = dyn FnOnce(&mut EcsWorld) -> BoxedResult<()> + Send;
 type Entry = (&'static str, Box<Update>);
 
 pub struct QueuedUpdates {
     // TODO use dynstack for updates to avoid a separate box per entry
-    // TODO perfect use case for a per-tick arena allocator
-    updates: RefCell<Vec<Entry>>,
+    // TODO move entries into the FrameAllocator arena, blocked on bump-allocated boxes
+    //  not being callable as FnOnce on stable
+    updates: Mutex<Vec<Entry>>,
 }
 
 impl Default for QueuedUpdates {
     fn default() -> Self {
         Self {
-            updates: RefCell::new(Vec::with_capacity(256)),
+            updates: Mutex::new(Vec::with_capacity(256)),
         }
     }
 }
 
 impl QueuedUpdates {
-    pub fn queue<F: 'static + FnOnce(&mut EcsWorld) -> Result<(), Box<dyn Error>>>(
+    pub fn queue<F: 'static + FnOnce(&mut EcsWorld) -> BoxedResult<()> + Send>(
         &self,
         name: &'static str,
         update: F,
     ) {
         // TODO pool/reuse these boxes
         let update = Box::new(update);
-        let mut updates = self.updates.borrow_mut();
+        let mut updates = self.updates.lock();
         let old_len = updates.len();
         updates.push((name, update));
 
@@ -42,7 +43,7 @@ impl QueuedUpdates {
     }
 
     pub fn execute(&mut self, world: &mut EcsWorld) {
-        let mut vec = self.updates.borrow_mut();
+        let mut vec = self.updates.lock();
         if !vec.is_empty() {
             debug!("running {count} queued updates", count = vec.len());
 
@@ -0,0 +1,65 @@
+use std::collections::HashSet;
+
+use crate::ecs::*;
+use crate::simulation::Tick;
+
+/// Number of round-robin buckets entities are spread across, i.e. each entity is due every
+/// this many ticks
+const BUCKETS: u32 = 10;
+
+/// Spreads the per-entity work of expensive systems (ai, senses) across ticks. Entities are
+/// assigned round-robin to a bucket by their id and only the due bucket is processed each
+/// tick, flattening tick time spikes without changing each entity's effective rate
+#[derive(Default)]
+pub struct EntityTickScheduler {
+    /// Entities due next tick regardless of their bucket, e.g. an interrupted activity
+    /// needing a new decision immediately
+    urgent: HashSet<Entity>,
+}
+
+impl EntityTickScheduler {
+    pub fn is_due(&self, entity: Entity, tick: Tick) -> bool {
+        entity.id() % BUCKETS == tick.value() % BUCKETS || self.urgent.contains(&entity)
+    }
+
+    /// Process the entity next tick instead of waiting for its bucket to come around
+    pub fn mark_urgent(&mut self, entity: Entity) {
+        self.urgent.insert(entity);
+    }
+
+    /// Called once per tick after the scheduled systems have run
+    pub fn clear_urgent(&mut self) {
+        self.urgent.clear();
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::ecs::*;
+    use crate::ComponentWorld;
+
+    #[test]
+    fn round_robin_and_urgency() {
+        let w = EcsWorld::new();
+        let e = w.create_entity().build();
+
+        let mut scheduler = EntityTickScheduler::default();
+
+        // due exactly once per full cycle
+        let due_count = (0..BUCKETS * 3)
+            .filter(|tick| scheduler.is_due(e, Tick::with(*tick)))
+            .count();
+        assert_eq!(due_count, 3);
+
+        // urgent entities are due regardless of bucket until cleared
+        let not_due = (0..BUCKETS)
+            .find(|tick| !scheduler.is_due(e, Tick::with(*tick)))
+            .unwrap();
+        scheduler.mark_urgent(e);
+        assert!(scheduler.is_due(e, Tick::with(not_due)));
+
+        scheduler.clear_urgent();
+        assert!(!scheduler.is_due(e, Tick::with(not_due)));
+    }
+}
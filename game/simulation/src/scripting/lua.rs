@@ -1,5 +1,9 @@
+use std::collections::hash_map::DefaultHasher;
+use std::collections::HashSet;
+use std::hash::Hasher;
+
 use rlua::prelude::*;
-use rlua::{Context, MetaMethod, StdLib, UserData, UserDataMethods, Variadic};
+use rlua::{Context, HookTriggers, MetaMethod, StdLib, UserData, UserDataMethods, Variadic};
 
 use crate::ecs::EntityWrapper;
 use crate::input::SelectedEntity;
@@ -11,11 +15,21 @@ use common::*;
 
 pub struct LuaScripting {
     runtime: rlua::Lua,
+
+    /// Source hashes whose compiled chunks are stashed in the lua registry, so repeat
+    /// executions of the same script skip compilation
+    // TODO evict cached chunks if scripts ever stop being occasional console commands
+    compiled: HashSet<u64>,
 }
 
 /// Key used in lua registry
 const GAME_STATE_KEY: &str = "game-state";
 
+/// Instructions a single script execution may run before it is terminated, so a runaway
+/// script can't stall the tick indefinitely. rlua can't yield from a hook, which rules
+/// out suspending and resuming the script next tick, so over budget is a hard error
+const INSTRUCTION_BUDGET: u32 = 5_000_000;
+
 /// Temporary references to game state for use in scripts. Only one script runs at a time
 #[derive(Clone)]
 struct LuaGameState<'a> {
@@ -61,7 +75,10 @@ impl Scripting for LuaScripting {
 
         runtime.context(populate_globals)?;
 
-        Ok(Self { runtime })
+        Ok(Self {
+            runtime,
+            compiled: HashSet::new(),
+        })
     }
 
     fn run(
@@ -79,12 +96,50 @@ impl Scripting for LuaScripting {
             safety_guard: Default::default(),
         };
 
-        self.runtime.context(|ctx| {
+        let hash = {
+            let mut hasher = DefaultHasher::new();
+            hasher.write(script);
+            hasher.finish()
+        };
+        let cache_key = format!("compiled-chunk-{:x}", hash);
+
+        // terminate scripts that run away with the tick thread
+        self.runtime.set_hook(
+            HookTriggers {
+                every_nth_instruction: Some(INSTRUCTION_BUDGET),
+                ..Default::default()
+            },
+            |_, _| {
+                Err(rlua::Error::external(
+                    "script exceeded its instruction budget",
+                ))
+            },
+        );
+
+        // borrowed separately so the closure doesn't need all of self while runtime is borrowed
+        let compiled = &mut self.compiled;
+
+        let result = self.runtime.context(|ctx| {
             let guard = state.install(ctx)?;
-            let result = ctx.load(script).exec();
+
+            // reuse the compiled chunk from a previous execution, compiling on miss
+            let chunk: rlua::Function = if compiled.contains(&hash) {
+                trace!("reusing cached script chunk"; "key" => &cache_key);
+                ctx.named_registry_value(&cache_key)?
+            } else {
+                let chunk = ctx.load(script).into_function()?;
+                ctx.set_named_registry_value(&cache_key, chunk.clone())?;
+                compiled.insert(hash);
+                chunk
+            };
+
+            let result = chunk.call::<_, ()>(());
             guard.uninstall(ctx)?;
             result
-        })?;
+        });
+
+        self.runtime.remove_hook();
+        result?;
 
         Ok(output)
     }
@@ -1,15 +1,19 @@
 use crate::ecs::*;
+use crate::scheduler::EntityTickScheduler;
 use crate::senses::sense::{HearingSphere, Sense, VisionCone};
+use crate::simulation::Tick;
 use crate::spatial::Spatial;
 use crate::TransformComponent;
 use common::*;
 use serde::Deserialize;
+// not re-exported from the ecs module, it would clash with the event queue's own BitSet
+use specs::BitSet;
 use std::collections::hash_map::DefaultHasher;
 use std::hash::Hasher;
 use unit::world::WorldPoint;
 
 /// Ticks to remember a sensed entity
-const SENSE_DECAY: u8 = 40;
+const SENSE_EXPIRY: u32 = 40;
 
 /// Populated by other systems with the available sense ranges
 #[derive(Component, EcsComponent, Default)]
@@ -19,16 +23,20 @@ pub struct SensesComponent {
     pub vision: ArrayVec<VisionCone, 1>,
     pub hearing: ArrayVec<HearingSphere, 1>,
 
-    /// Sensed entities this tick
-    /// TODO maybe the ecs bitmask can be reused here instead of a huge alloc per entity
-    sensed: Vec<SensedEntity>,
+    /// Sensed entity ids, the same fixed bitset the ecs uses, for O(1) membership checks
+    /// without an allocation proportional to the population
+    sensed: BitSet,
+
+    /// Details per sensed entity. Allocation is reused, entries are renewed in place and
+    /// only dropped once expired
+    entries: Vec<SensedEntity>,
 }
 
 struct SensedEntity {
     entity: Entity,
     how: Sense,
-    /// Expired when 0
-    decay: u8,
+    /// No longer sensed once the current tick passes this
+    expiry: Tick,
 }
 
 /// Dummy magical sense provider - this will be replaced by individual body parts that provide the
@@ -46,17 +54,21 @@ pub struct SensesSystem;
 impl<'a> System<'a> for SensesSystem {
     type SystemData = (
         Read<'a, Spatial>,
+        Read<'a, EntityTickScheduler>,
+        Read<'a, FrameAllocator>,
         Read<'a, EntitiesRes>,
         ReadStorage<'a, MagicalSenseComponent>,
         ReadStorage<'a, TransformComponent>,
         WriteStorage<'a, SensesComponent>,
     );
 
-    fn run(&mut self, (spatial, entities, providers, transforms, mut senses): Self::SystemData) {
+    fn run(
+        &mut self,
+        (spatial, scheduler, allocator, entities, providers, transforms, mut senses): Self::SystemData,
+    ) {
         log_scope!(o!("system" => "senses"));
 
-        // TODO system is expensive, dont run every tick
-        // TODO consider using expiry times rather than decrementing a decay counter
+        let tick = Tick::fetch();
 
         // update sense capabilities
         for (e, provider, senses) in (&entities, &providers, &mut senses).join() {
@@ -72,36 +84,48 @@ impl<'a> System<'a> for SensesSystem {
             }
         }
 
-        // use senses
+        // gather the sensors due this tick, pruning their expired entries on the way
+        let frame = allocator.frame();
+        let mut sensors = FrameVec::new_in(&frame);
+        let mut queries = FrameVec::new_in(&frame);
         for (e, senses, transform) in (&entities, &mut senses, &transforms).join() {
-            log_scope!(o!(E(e)));
+            if !scheduler.is_due(e, tick) {
+                continue;
+            }
 
-            senses.decay_sensed_entities();
+            senses.prune_expired(tick);
 
-            // do a single query for all senses
             let max_radius = match senses.max_radius() {
                 Some(f) => f,
                 None => {
                     // no senses
-                    trace!("no senses");
+                    trace!("no senses"; E(e));
                     continue;
                 }
             };
 
             // TODO specialize query e.g. only detect those with a given component combo e.g. Transform + Render (+ Visible/!Invisible?)
 
-            spatial
-                .query_in_radius(transform.position, max_radius)
-                .filter(|(entity, _, _)| *entity != e) // TODO self is probably the first in the list
-                .for_each(|(entity, pos, dist)| {
-                    let sensed = senses.senses(transform, &pos, dist);
-                    if !sensed.is_empty() {
-                        senses.add_sensed_entity(entity, sensed);
-                    }
-                });
-
-            trace!("senses {count} entities", count = senses.sensed.len());
+            sensors.push((e, transform));
+            queries.push((transform.position, max_radius));
         }
+
+        trace!("sensing with {count} sensors", count = sensors.len());
+
+        // sweep the spatial grid once for all sensors together
+        let expiry = tick + SENSE_EXPIRY;
+        spatial.query_in_radius_batch(&queries, |sensor_idx, entity, pos, dist| {
+            let (sensor, transform) = sensors[sensor_idx];
+            if entity == sensor {
+                return;
+            }
+
+            let senses = senses.get_mut(sensor).expect("sensor was just joined");
+            let sensed = senses.senses(transform, &pos, dist);
+            if !sensed.is_empty() {
+                senses.add_sensed_entity(entity, sensed, expiry);
+            }
+        });
     }
 }
 
@@ -154,38 +178,58 @@ impl SensesComponent {
     }
 
     pub fn sensed_entities(&self) -> impl Iterator<Item = Entity> + '_ {
-        self.sensed.iter().map(|s| s.entity)
+        let now = Tick::fetch();
+        self.entries
+            .iter()
+            .filter(move |s| !s.is_expired(now))
+            .map(|s| s.entity)
     }
 
-    fn add_sensed_entity(&mut self, e: Entity, how: Sense) {
+    /// O(1) check against the sensed bitset. May include entries that expired since the
+    /// last update
+    pub fn is_sensing(&self, e: Entity) -> bool {
+        self.sensed.contains(e.id())
+    }
+
+    fn add_sensed_entity(&mut self, e: Entity, how: Sense, expiry: Tick) {
         debug_assert!(!how.is_empty());
 
-        if let Some(existing) = self.sensed.iter_mut().find(|s| s.entity == e) {
-            // renew decay
-            existing.decay = SENSE_DECAY;
+        if self.sensed.add(e.id()) {
+            // already known, renew in place. compare by id in case the entity was
+            // replaced by a new generation since
+            let existing = self
+                .entries
+                .iter_mut()
+                .find(|s| s.entity.id() == e.id())
+                .expect("sensed bitset out of sync with entries");
+            existing.entity = e;
+            existing.how = how;
+            existing.expiry = expiry;
         } else {
             // new entity
-            self.sensed.push(SensedEntity {
+            self.entries.push(SensedEntity {
                 entity: e,
                 how,
-                decay: SENSE_DECAY,
+                expiry,
             })
         }
     }
 
-    fn decay_sensed_entities(&mut self) {
-        // decrement
-        self.sensed
-            .iter_mut()
-            .for_each(|s| s.decay = s.decay.saturating_sub(1));
-
-        // sort expired to the end
-        self.sensed.sort_unstable_by_key(|s| s.decay > 0);
+    fn prune_expired(&mut self, now: Tick) {
+        let sensed = &mut self.sensed;
+        self.entries.retain(|s| {
+            let expired = s.is_expired(now);
+            if expired {
+                sensed.remove(s.entity.id());
+            }
+            !expired
+        });
+    }
+}
 
-        if let Some(first_expired) = self.sensed.iter().position(|s| s.decay == 0) {
-            let count = self.sensed.drain(first_expired..).count();
-            trace!("removed {count} expired sensed entities", count = count);
-        }
+impl SensedEntity {
+    fn is_expired(&self, now: Tick) -> bool {
+        now.value() >= self.expiry.value()
     }
 }
 
@@ -5,7 +5,7 @@ use resources::Resources;
 use strum_macros::EnumDiscriminants;
 use unit::world::WorldPositionRange;
 use world::block::BlockType;
-use world::loader::{TerrainUpdatesRes, WorldTerrainUpdate};
+use world::loader::{PathRequest, PathRequestId, TerrainUpdatesRes, WorldTerrainUpdate};
 use world::WorldChangeEvent;
 
 use crate::activity::{ActivityEventSystem, ActivitySystem};
@@ -18,9 +18,14 @@ use crate::input::{
     UiCommand, UiRequest, UiResponsePayload,
 };
 use crate::item::{ContainerComponent, HaulSystem};
+use crate::scheduler::EntityTickScheduler;
 use crate::movement::MovementFulfilmentSystem;
 use crate::needs::{EatingSystem, HungerSystem};
-use crate::path::{NavigationAreaDebugRenderer, PathDebugRenderer, PathSteeringSystem};
+use crate::perf::TimedSystem;
+use crate::path::{
+    NavigationAreaDebugRenderer, PathDebugRenderer, PathRequestsRes, PathResultsRes,
+    PathSteeringSystem, PathToken,
+};
 use crate::physics::PhysicsSystem;
 use crate::queued_update::QueuedUpdates;
 use crate::render::{
@@ -39,7 +44,7 @@ use crate::{
     definitions, EntityLoggingComponent, Exit, ThreadedWorldLoader, WorldRef, WorldViewer,
 };
 use crate::{ComponentWorld, Societies, SocietyHandle};
-use std::collections::HashSet;
+use std::collections::{HashMap, HashSet};
 
 #[derive(Debug, EnumDiscriminants)]
 #[strum_discriminants(name(AssociatedBlockDataType))]
@@ -62,6 +67,10 @@ pub struct Simulation<R: Renderer> {
     ecs_world: EcsWorld,
     voxel_world: WorldRef,
 
+    /// Dependency-aware parallel system executor, rebuilt is not needed as the system graph is
+    /// static
+    system_dispatcher: Dispatcher<'static, 'static>,
+
     world_loader: ThreadedWorldLoader,
 
     /// Terrain updates, queued and applied per tick
@@ -71,6 +80,10 @@ pub struct Simulation<R: Renderer> {
     /// World change events populated during terrain updates, consumed every tick
     change_events: Vec<WorldChangeEvent>,
 
+    /// Async path searches submitted to the world loader, awaiting their results
+    path_requests_in_flight: HashMap<PathRequestId, (Entity, PathToken)>,
+    next_path_request: u64,
+
     debug_renderers: DebugRenderers<R>,
     scripting: ScriptingContext,
 }
@@ -107,16 +120,22 @@ impl<R: Renderer> Simulation<R> {
 
         let debug_renderers = register_debug_renderers()?;
 
+        let mut system_dispatcher = build_system_dispatcher();
+        system_dispatcher.setup(&mut ecs_world);
+
         // ensure tick is reset
         reset_tick();
 
         Ok(Self {
             ecs_world,
             voxel_world,
+            system_dispatcher,
             world_loader,
             debug_renderers,
             terrain_changes: HashSet::with_capacity(1024),
             change_events: Vec::with_capacity(1024),
+            path_requests_in_flight: HashMap::with_capacity(64),
+            next_path_request: 0,
             scripting: ScriptingContext::new()?,
         })
     }
@@ -129,6 +148,9 @@ impl<R: Renderer> Simulation<R> {
         // update tick
         increment_tick();
 
+        // all scratch allocations from last tick are dead, reclaim them in one go
+        self.ecs_world.resource_mut::<FrameAllocator>().reset();
+
         // TODO sort out systems so they all have an ecs_world reference and can keep state
         // safety: only lives for the duration of this tick
         let ecs_ref = unsafe { EcsWorldFrameRef::init(&self.ecs_world) };
@@ -162,43 +184,19 @@ impl<R: Renderer> Simulation<R> {
         #[cfg(debug_assertions)]
         crate::item::validation::InventoryValidationSystem.run_now(&self.ecs_world);
 
-        // needs
-        HungerSystem.run_now(&self.ecs_world);
-        EatingSystem.run_now(&self.ecs_world);
-
-        // update senses
-        SensesSystem.run_now(&self.ecs_world);
-
-        // choose and tick activity
-        AiSystem.run_now(&self.ecs_world);
-        ActivitySystem.run_now(&self.ecs_world);
-
-        // follow paths with steering
-        PathSteeringSystem.run_now(&self.ecs_world);
-
-        // apply steering
-        SteeringSystem.run_now(&self.ecs_world);
-
-        // attempt to fulfil desired velocity
-        MovementFulfilmentSystem.run_now(&self.ecs_world);
-
-        // process entity events
-        ActivityEventSystem.run_now(&self.ecs_world);
-
-        // apply physics
-        PhysicsSystem.run_now(&self.ecs_world);
-
-        // sync hauled item positions
-        HaulSystem.run_now(&self.ecs_world);
-
-        // update spatial
-        SpatialSystem.run_now(&self.ecs_world);
+        // run all systems on the thread pool, with independent systems running concurrently
+        self.system_dispatcher.dispatch(&self.ecs_world);
     }
 
     pub fn voxel_world(&self) -> WorldRef {
         self.voxel_world.clone()
     }
 
+    /// For spawning mesh generation tasks on the world loader's worker pool
+    pub fn world_worker_handle(&self) -> crate::WorkerHandle {
+        self.world_loader.worker_handle()
+    }
+
     pub fn world_mut(&mut self) -> &mut EcsWorld {
         &mut self.ecs_world
     }
@@ -216,7 +214,10 @@ impl<R: Renderer> Simulation<R> {
     }
 
     fn apply_world_updates(&mut self, world_viewer: &mut WorldViewer) {
-        // request new slabs
+        // request new slabs, nearest the camera first
+        self.world_loader
+            .update_viewer_priority(world_viewer.centre_slab());
+
         let discovered = empty(); // TODO include slabs discovered by members of player's society
         let requested_slabs = world_viewer.requested_slabs(discovered);
         let actual_requested_slabs = requested_slabs.as_ref().iter().copied();
@@ -225,9 +226,11 @@ impl<R: Renderer> Simulation<R> {
 
         let mut world = self.voxel_world.borrow_mut();
 
-        // apply occlusion updates
+        // apply occlusion updates accumulated since last tick in one batch
+        let mut occlusion_updates = Vec::new();
         self.world_loader
-            .iter_occlusion_updates(|update| world.apply_occlusion_update(update));
+            .iter_occlusion_updates(|update| occlusion_updates.push(update));
+        world.apply_occlusion_updates_batch(occlusion_updates);
 
         // mark modified slabs as dirty in world viewer, which will cache it until the slab is visible
         world.dirty_slabs().for_each(|s| world_viewer.mark_dirty(s));
@@ -266,6 +269,45 @@ impl<R: Renderer> Simulation<R> {
         let empty = std::mem::replace(&mut self.change_events, events);
         debug_assert!(empty.is_empty());
         std::mem::forget(empty);
+
+        // exchange path requests and results with the loader's async path service
+        self.apply_path_updates();
+    }
+
+    fn apply_path_updates(&mut self) {
+        // forward completed async searches to the steering system
+        let results = self.ecs_world.resource_mut::<PathResultsRes>();
+        let in_flight = &mut self.path_requests_in_flight;
+        self.world_loader
+            .iter_path_results(|id, result| match in_flight.remove(&id) {
+                Some((entity, token)) => results.0.push((entity, token, result)),
+                None => warn!("dropping result for unknown path request"; "request" => ?id),
+            });
+
+        // submit searches queued by systems this tick in a single batch
+        let requests = self.ecs_world.resource_mut::<PathRequestsRes>();
+        if !requests.0.is_empty() {
+            debug!(
+                "submitting {count} path requests to the loader",
+                count = requests.0.len()
+            );
+
+            let next_id = &mut self.next_path_request;
+            let batch = requests.0.drain(..).map(|req| {
+                let id = PathRequestId(*next_id);
+                *next_id += 1;
+
+                in_flight.insert(id, (req.entity, req.token));
+                PathRequest {
+                    id,
+                    from: req.from,
+                    to: req.to,
+                    goal: req.goal,
+                }
+            });
+
+            self.world_loader.request_paths(batch);
+        }
     }
 
     fn process_ui_commands(&mut self, commands: impl Iterator<Item = UiCommand>) -> Option<Exit> {
@@ -544,8 +586,52 @@ impl Add<u32> for Tick {
     }
 }
 
+fn build_system_dispatcher() -> Dispatcher<'static, 'static> {
+    // the explicit dependencies express ordering requirements, everything else is free to run
+    // concurrently on the thread pool (subject to conflicting component/resource access)
+    DispatcherBuilder::new()
+        .with(TimedSystem(HungerSystem, "hunger"), "hunger", &[])
+        .with(TimedSystem(EatingSystem, "eating"), "eating", &["hunger"])
+        .with(TimedSystem(SensesSystem, "senses"), "senses", &[])
+        .with(TimedSystem(AiSystem, "ai"), "ai", &["eating", "senses"])
+        .with(TimedSystem(ActivitySystem, "activity"), "activity", &["ai"])
+        .with(
+            TimedSystem(PathSteeringSystem, "path-steering"),
+            "path-steering",
+            &["activity"],
+        )
+        .with(
+            TimedSystem(SteeringSystem, "steering"),
+            "steering",
+            &["path-steering"],
+        )
+        .with(
+            TimedSystem(MovementFulfilmentSystem, "movement"),
+            "movement",
+            &["steering"],
+        )
+        .with(
+            TimedSystem(ActivityEventSystem, "activity-events"),
+            "activity-events",
+            &["movement"],
+        )
+        .with(
+            TimedSystem(PhysicsSystem, "physics"),
+            "physics",
+            &["activity-events"],
+        )
+        .with(TimedSystem(HaulSystem, "haul"), "haul", &["physics"])
+        .with(
+            TimedSystem(SpatialSystem, "spatial"),
+            "spatial",
+            &["physics"],
+        )
+        .build()
+}
+
 fn register_resources(world: &mut EcsWorld) {
     world.insert(QueuedUpdates::default());
+    world.insert(FrameAllocator::default());
     world.insert(SelectedEntity::default());
     world.insert(SelectedTiles::default());
     world.insert(TerrainUpdatesRes::default());
@@ -553,7 +639,10 @@ fn register_resources(world: &mut EcsWorld) {
     world.insert(PlayerSociety::default());
     world.insert(EntityEventQueue::default());
     world.insert(Spatial::default());
+    world.insert(EntityTickScheduler::default());
     world.insert(EntityTimers::default());
+    world.insert(PathRequestsRes::default());
+    world.insert(PathResultsRes::default());
 }
 
 fn register_debug_renderers<R: Renderer>() -> Result<DebugRenderers<R>, DebugRendererError> {
@@ -6,7 +6,7 @@ use common::parking_lot::RwLock;
 use common::*;
 use std::convert::TryFrom;
 use std::ops::Deref;
-use std::rc::Rc;
+use std::sync::Arc;
 
 /// A high-level society job that produces a number of [SocietyTask]s
 pub struct SocietyJob {
@@ -23,14 +23,14 @@ pub struct SocietyJob {
 #[derive(Debug)]
 pub enum SocietyTaskResult {
     Success,
-    Failure(Box<dyn Error>),
+    Failure(Box<dyn Error + Send + Sync>),
 }
 
 #[repr(transparent)]
 #[derive(Clone)]
-pub struct SocietyJobRef(Rc<RwLock<SocietyJob>>);
+pub struct SocietyJobRef(Arc<RwLock<SocietyJob>>);
 
-pub trait SocietyJobImpl: Display + Debug {
+pub trait SocietyJobImpl: Display + Debug + Send + Sync {
     /// [refresh] will be called after this before any tasks are dished out, so this can eagerly add
     /// tasks without filtering.
     ///
@@ -87,7 +87,7 @@ impl SocietyJob {
         let mut tasks = Vec::new();
         job.populate_initial_tasks(world, &mut tasks);
 
-        SocietyJobRef(Rc::new(RwLock::new(SocietyJob {
+        SocietyJobRef(Arc::new(RwLock::new(SocietyJob {
             tasks,
             pending_complete: Vec::new(),
             inner: Box::new(job),
@@ -153,7 +153,7 @@ impl Debug for SocietyJobRef {
 }
 
 impl Deref for SocietyJobRef {
-    type Target = Rc<RwLock<SocietyJob>>;
+    type Target = Arc<RwLock<SocietyJob>>;
 
     fn deref(&self) -> &Self::Target {
         &self.0
@@ -12,6 +12,16 @@ pub struct SocietyJobList {
     reservations: SocietyTaskReservations,
     last_update: Tick,
 
+    /// Entity-independent snapshot of every task with its job index and total reservation
+    /// count, so per-entity filtering doesn't walk jobs and reservations each time
+    task_snapshot: Vec<(SocietyTask, JobIndex, ReservationCount)>,
+
+    /// Scratch buffer for rebuilding [task_snapshot], allocation reused
+    snapshot_scratch: Vec<(SocietyTask, JobIndex, ReservationCount)>,
+
+    /// Bumped when the content of [task_snapshot] changes
+    snapshot_generation: u64,
+
     /// Pretty hacky way to prevent Job indices changing
     no_more_jobs_temporarily: bool,
 }
@@ -25,6 +35,8 @@ pub struct Reservations<T> {
     reservations: Vec<(T, Entity)>,
     /// Fast check for membership in reservations
     task_membership: HashMap<T, ReservationCount>,
+    /// Bumped on every reserve/cancel that changes anything
+    generation: u64,
 }
 
 pub trait ReservationTask: Clone + Hash + Eq + Debug {
@@ -45,6 +57,9 @@ impl Default for SocietyJobList {
             jobs: Vec::with_capacity(64),
             reservations: SocietyTaskReservations::default(),
             last_update: Tick::default(),
+            task_snapshot: Vec::with_capacity(64),
+            snapshot_scratch: Vec::new(),
+            snapshot_generation: 0,
             no_more_jobs_temporarily: false,
         }
     }
@@ -60,6 +75,65 @@ impl SocietyJobList {
         self.jobs.push(job);
     }
 
+    /// Refreshes jobs and rebuilds the task snapshot at most once per tick, and pins job
+    /// indices until [allow_jobs_again] is called
+    pub fn refresh_if_needed(&mut self, this_tick: Tick, world: &EcsWorld) {
+        // reset when finished with tasks
+        self.no_more_jobs_temporarily = true;
+
+        if self.last_update == this_tick {
+            return;
+        }
+        self.last_update = this_tick;
+
+        let len_before = self.jobs.len();
+        trace!("refreshing {n} jobs", n = len_before);
+        self.jobs.retain(|job| {
+            let result = job.write().refresh_tasks(world);
+            match result {
+                None => true,
+                Some(result) => {
+                    debug!("job finished"; "result" => ?result, "job" => ?job);
+                    false
+                }
+            }
+        });
+
+        let len_after = self.jobs.len();
+        if len_before != len_after {
+            trace!("pruned {n} finished jobs", n = len_before - len_after);
+        }
+
+        // rebuild the snapshot and only bump the generation if it actually changed
+        debug_assert!(self.snapshot_scratch.is_empty());
+        for (i, job) in self.jobs.iter().enumerate() {
+            let job = job.read();
+            for task in job.tasks() {
+                let count = self.reservations.count_for(task);
+                self.snapshot_scratch.push((task.clone(), i, count));
+            }
+        }
+
+        if self.snapshot_scratch != self.task_snapshot {
+            std::mem::swap(&mut self.snapshot_scratch, &mut self.task_snapshot);
+            self.snapshot_generation += 1;
+            trace!(
+                "society task snapshot changed";
+                "generation" => self.snapshot_generation,
+                "tasks" => self.task_snapshot.len(),
+            );
+        }
+        self.snapshot_scratch.clear();
+    }
+
+    /// Changes whenever the result of [filter_applicable_tasks] could change for any
+    /// entity, so callers can reuse their last filtered result while it stays the same.
+    /// Only valid after [refresh_if_needed] this tick
+    pub fn generation(&self) -> u64 {
+        // both counters only ever increment, so the sum is monotonic too
+        self.snapshot_generation + self.reservations.generation
+    }
+
     /// Returned job index is valid until [allow_jobs_again] is called
     pub fn filter_applicable_tasks(
         &mut self,
@@ -68,51 +142,19 @@ impl SocietyJobList {
         world: &EcsWorld,
         tasks_out: &mut Vec<(SocietyTask, JobIndex, ReservationCount)>,
     ) {
-        // refresh jobs if necessary
-        if self.last_update != this_tick {
-            self.last_update = this_tick;
-            let len_before = self.jobs.len();
-            trace!("refreshing {n} jobs", n = len_before);
-            self.jobs.retain(|job| {
-                let result = job.write().refresh_tasks(world);
-                match result {
-                    None => true,
-                    Some(result) => {
-                        debug!("job finished"; "result" => ?result, "job" => ?job);
-                        false
-                    }
-                }
-            });
-
-            let len_after = self.jobs.len();
-            if len_before != len_after {
-                trace!("pruned {n} finished jobs", n = len_before - len_after);
-            }
-        }
-
-        // reset when finished with tasks
-        self.no_more_jobs_temporarily = true;
-
-        for (i, job) in self.jobs.iter().enumerate() {
-            let job = job.read();
-            // TODO filter jobs for entity
-
-            for task in job.tasks() {
-                use Reservation::*;
-                match self.reservations.check_for(task, entity) {
-                    Unreserved | ReservedBySelf => {
-                        // wonderful, this task is fully available
-                        tasks_out.push((task.clone(), i, 0));
-                    }
-                    ReservedButShareable(n) => {
-                        // this task is available but already reserved by others
-                        tasks_out.push((task.clone(), i, n));
-                    }
-                    Unavailable => {
-                        // not available
-                    }
-                }
+        self.refresh_if_needed(this_tick, world);
+
+        // TODO filter tasks for entity capabilities
+        let own_task = self.reservation(entity);
+        for (task, job_idx, count) in self.task_snapshot.iter() {
+            if *count == 0 || own_task == Some(task) {
+                // wonderful, this task is fully available (or already reserved by us)
+                tasks_out.push((task.clone(), *job_idx, 0));
+            } else if task.is_shareable() {
+                // this task is available but already reserved by others
+                tasks_out.push((task.clone(), *job_idx, *count));
             }
+            // else: unshareable and reserved by someone else
         }
     }
 
@@ -165,6 +207,7 @@ impl<T> Default for Reservations<T> {
         Self {
             reservations: Vec::with_capacity(128),
             task_membership: HashMap::with_capacity(128),
+            generation: 0,
         }
     }
 }
@@ -190,6 +233,7 @@ impl<T: ReservationTask> Reservations<T> {
 
             self.add_ref(tup.0);
             self.release_ref(&prev);
+            self.generation += 1;
 
             // ensure no other reservations
             debug_assert!(
@@ -205,9 +249,14 @@ impl<T: ReservationTask> Reservations<T> {
             debug!("adding new reservation"; E(reserver), "new" => ?tup.0.clone());
             self.add_ref(tup.0.clone());
             self.reservations.push(tup);
+            self.generation += 1;
         }
     }
 
+    fn count_for(&self, task: &T) -> ReservationCount {
+        self.task_membership.get(task).copied().unwrap_or(0)
+    }
+
     fn add_ref(&mut self, task: T) {
         *self.task_membership.entry(task).or_default() += 1;
     }
@@ -228,6 +277,7 @@ impl<T: ReservationTask> Reservations<T> {
         if let Some(current_idx) = self.reservations.iter().position(|(_, e)| *e == reserver) {
             let (prev, _) = self.reservations.swap_remove(current_idx);
             self.release_ref(&prev);
+            self.generation += 1;
             debug!("unreserved task"; E(reserver), "prev" => ?prev);
 
             // ensure no other reservations
@@ -402,6 +452,24 @@ mod tests {
         assert_eq!(reservations.check_for(&task, c), Reservation::Unreserved);
     }
 
+    #[test]
+    fn reservation_generation() {
+        let (mut reservations, [a, b, _]) = create();
+
+        let initial = reservations.generation;
+        reservations.reserve(2, a);
+        assert!(reservations.generation > initial);
+
+        // no-ops don't bump it
+        let current = reservations.generation;
+        reservations.reserve(2, a); // dupe
+        reservations.cancel(b); // nothing reserved
+        assert_eq!(reservations.generation, current);
+
+        reservations.cancel(a);
+        assert!(reservations.generation > current);
+    }
+
     #[test]
     fn check_all() {
         let (mut reservations, [a, b, c]) = create();
@@ -2,7 +2,7 @@ pub use jobs::*;
 pub use task::SocietyTask;
 
 pub use self::job::{SocietyCommand, SocietyJob, SocietyJobRef, SocietyTaskResult};
-pub use list::{JobIndex, Reservation, SocietyJobList};
+pub use list::{JobIndex, Reservation, ReservationCount, SocietyJobList};
 
 mod job;
 mod jobs;
@@ -3,13 +3,13 @@ use crate::item::ContainerComponent;
 use crate::job::SocietyJobList;
 use crate::{ComponentWorld, SocietyHandle};
 use common::*;
-use std::cell::{Ref, RefCell, RefMut};
+use common::parking_lot::{RwLock, RwLockReadGuard, RwLockWriteGuard};
 use std::collections::HashSet;
 
 pub struct Society {
     name: String,
     handle: SocietyHandle,
-    jobs: RefCell<SocietyJobList>,
+    jobs: RwLock<SocietyJobList>,
 
     /// Communal containers
     containers: HashSet<Entity>,
@@ -20,7 +20,7 @@ impl Society {
         Self {
             name,
             handle,
-            jobs: RefCell::new(Default::default()),
+            jobs: RwLock::new(Default::default()),
             containers: HashSet::new(),
         }
     }
@@ -33,12 +33,12 @@ impl Society {
         self.handle
     }
 
-    pub fn jobs(&self) -> Ref<SocietyJobList> {
-        self.jobs.borrow()
+    pub fn jobs(&self) -> RwLockReadGuard<SocietyJobList> {
+        self.jobs.read()
     }
 
-    pub fn jobs_mut(&self) -> RefMut<SocietyJobList> {
-        self.jobs.borrow_mut()
+    pub fn jobs_mut(&self) -> RwLockWriteGuard<SocietyJobList> {
+        self.jobs.write()
     }
 
     /// The given container must already be set to communal, returns true if successful
@@ -91,7 +91,7 @@ impl Debug for Society {
         f.debug_struct("Society")
             .field("name", &self.name)
             .field("handle", &self.handle)
-            .field("jobs", &*self.jobs.borrow())
+            .field("jobs", &*self.jobs.read())
             .field("containers", &self.containers.len())
             .finish()
     }
@@ -1,15 +1,29 @@
+use std::collections::HashMap;
+
 use crate::ecs::*;
-use crate::simulation::Tick;
 use crate::{PhysicalComponent, TransformComponent};
 use common::*;
 use unit::world::WorldPoint;
 
-// TODO reimplement with octree
+/// Side length of a cubic grid cell in blocks. Should be comparable to typical sense/query radii
+/// so most queries touch only a handful of cells
+const CELL_SIZE: f32 = 8.0;
+
+/// Cell coordinate in the uniform grid, i.e. world position / [CELL_SIZE]
+type Cell = (i32, i32, i32);
 
-/// Implements efficient spatial entity queries
+/// Implements efficient spatial entity queries with a uniform hash grid over world space,
+/// maintained incrementally by [SpatialSystem]
 pub struct Spatial {
-    /// Really stupid implementation for now
-    entities: Vec<(Entity, WorldPoint)>,
+    /// Sparse grid of occupied cells. Entity positions are duplicated here so queries don't need
+    /// a second lookup per candidate
+    cells: HashMap<Cell, SmallVec<[(Entity, WorldPoint); 8]>>,
+
+    /// Last known cell and position per tracked entity, for detecting moves and stale entries
+    entities: HashMap<Entity, (Cell, WorldPoint)>,
+
+    /// Reused buffer for entities to untrack this update
+    dead_scratch: Vec<Entity>,
 }
 
 /// Update spatial resource
@@ -18,7 +32,9 @@ pub struct SpatialSystem;
 impl Default for Spatial {
     fn default() -> Self {
         Self {
-            entities: Vec::with_capacity(256),
+            cells: HashMap::with_capacity(64),
+            entities: HashMap::with_capacity(256),
+            dead_scratch: Vec::new(),
         }
     }
 }
@@ -30,38 +46,156 @@ impl Spatial {
         transforms: ReadStorage<TransformComponent>,
         physicals: ReadStorage<PhysicalComponent>,
     ) {
-        self.entities.clear();
+        // untrack entities that died or lost their components since last tick
+        debug_assert!(self.dead_scratch.is_empty());
+        self.dead_scratch.extend(
+            self.entities
+                .keys()
+                .filter(|e| {
+                    !entities.is_alive(**e)
+                        || !transforms.contains(**e)
+                        || !physicals.contains(**e)
+                })
+                .copied(),
+        );
+        for e in self.dead_scratch.drain(..) {
+            if let Some((cell, _)) = self.entities.remove(&e) {
+                remove_from_cell(&mut self.cells, cell, e);
+            }
+        }
 
+        // track new entities and move those that changed position
         for (e, transform, _) in (&entities, &transforms, &physicals).join() {
-            self.entities.push((e, transform.position));
-        }
+            let position = transform.position;
+            let new_cell = cell_containing(position);
 
-        if !self.entities.is_empty() {
-            debug!(
-                "updated spatial index with {count} entities",
-                count = self.entities.len()
-            );
+            match self.entities.insert(e, (new_cell, position)) {
+                None => {
+                    // new entity
+                    self.cells.entry(new_cell).or_default().push((e, position));
+                }
+                Some((old_cell, _)) if old_cell != new_cell => {
+                    // moved across a cell boundary
+                    remove_from_cell(&mut self.cells, old_cell, e);
+                    self.cells.entry(new_cell).or_default().push((e, position));
+                }
+                Some((_, old_position)) => {
+                    // moved within the same cell, just refresh the stored position
+                    if old_position.distance2(position) > 0.0 {
+                        let cell = self
+                            .cells
+                            .get_mut(&new_cell)
+                            .expect("tracked entity missing from its cell");
+                        if let Some((_, pos)) = cell.iter_mut().find(|(other, _)| *other == e) {
+                            *pos = position;
+                        }
+                    }
+                }
+            }
         }
     }
 
-    // The sort is a massive hotspot in profiling, keeping this not-inlined helps this terrible
-    // TEMPORARY method stand out
-    #[inline(never)]
+    /// Yields all entities within the given radius of the centre in an unspecified order, with
+    /// their position and distance. Visits only the grid cells overlapping the query sphere and
+    /// does not allocate
     pub fn query_in_radius(
         &self,
         centre: WorldPoint,
         radius: f32,
-    ) -> impl Iterator<Item = (Entity, WorldPoint, f32)> {
-        // awful allocation only acceptable because this is an awful temporary brute force implementation
-        self.entities
-            .iter()
-            .map(|(e, point)| {
-                let distance2 = point.distance2(centre);
-                (e, point, distance2)
+    ) -> impl Iterator<Item = (Entity, WorldPoint, f32)> + '_ {
+        let radius2 = radius.powi(2);
+        let (cx, cy, cz) = centre.xyz();
+        let (min, max) = (
+            cell_containing_xyz(cx - radius, cy - radius, cz - radius),
+            cell_containing_xyz(cx + radius, cy + radius, cz + radius),
+        );
+
+        (min.0..=max.0)
+            .cartesian_product(min.1..=max.1)
+            .cartesian_product(min.2..=max.2)
+            .filter_map(move |((x, y), z)| self.cells.get(&(x, y, z)))
+            .flat_map(move |cell| {
+                cell.iter().filter_map(move |(e, point)| {
+                    let distance2 = point.distance2(centre);
+                    (distance2 < radius2).as_some_from(|| (*e, *point, distance2.sqrt()))
+                })
             })
-            .filter(|(_, _, dist2)| *dist2 < radius.powi(2))
-            .map(|(e, point, dist2)| (*e, *point, dist2.sqrt()))
-            .sorted_by_key(|(_, _, dist)| OrderedFloat(*dist))
+    }
+
+    /// Runs many radius queries in a single sweep over the grid. Query spheres are bucketed
+    /// onto the occupied cells they overlap, so each cell's entity list is visited once for
+    /// all queries together rather than once per query.
+    ///
+    /// f(query index, entity, position, distance), called in an unspecified order
+    pub fn query_in_radius_batch(
+        &self,
+        queries: &[(WorldPoint, f32)],
+        mut f: impl FnMut(usize, Entity, WorldPoint, f32),
+    ) {
+        // TODO reuse allocation between calls
+        let mut cell_queries: HashMap<Cell, SmallVec<[usize; 4]>> =
+            HashMap::with_capacity(queries.len() * 4);
+
+        for (idx, (centre, radius)) in queries.iter().enumerate() {
+            let (cx, cy, cz) = centre.xyz();
+            let (min, max) = (
+                cell_containing_xyz(cx - radius, cy - radius, cz - radius),
+                cell_containing_xyz(cx + radius, cy + radius, cz + radius),
+            );
+
+            (min.0..=max.0)
+                .cartesian_product(min.1..=max.1)
+                .cartesian_product(min.2..=max.2)
+                .map(|((x, y), z)| (x, y, z))
+                .filter(|cell| self.cells.contains_key(cell))
+                .for_each(|cell| cell_queries.entry(cell).or_default().push(idx));
+        }
+
+        for (cell, interested) in cell_queries.iter() {
+            let entities = self
+                .cells
+                .get(cell)
+                .expect("only occupied cells are bucketed");
+
+            for (e, point) in entities.iter() {
+                for &idx in interested.iter() {
+                    let (centre, radius) = queries[idx];
+                    let distance2 = point.distance2(centre);
+                    if distance2 < radius.powi(2) {
+                        f(idx, *e, *point, distance2.sqrt());
+                    }
+                }
+            }
+        }
+    }
+}
+
+fn cell_containing(point: WorldPoint) -> Cell {
+    let (x, y, z) = point.xyz();
+    cell_containing_xyz(x, y, z)
+}
+
+fn cell_containing_xyz(x: f32, y: f32, z: f32) -> Cell {
+    (
+        (x / CELL_SIZE).floor() as i32,
+        (y / CELL_SIZE).floor() as i32,
+        (z / CELL_SIZE).floor() as i32,
+    )
+}
+
+fn remove_from_cell(
+    cells: &mut HashMap<Cell, SmallVec<[(Entity, WorldPoint); 8]>>,
+    cell: Cell,
+    entity: Entity,
+) {
+    if let Some(entities) = cells.get_mut(&cell) {
+        if let Some(idx) = entities.iter().position(|(e, _)| *e == entity) {
+            entities.swap_remove(idx);
+        }
+
+        if entities.is_empty() {
+            cells.remove(&cell);
+        }
     }
 }
 
@@ -74,10 +208,7 @@ impl<'a> System<'a> for SpatialSystem {
     );
 
     fn run(&mut self, (entities, transforms, physicals, mut spatial): Self::SystemData) {
-        // only update occasionally
-        let tick = Tick::fetch();
-        if tick.value() % 8 == 0 {
-            spatial.update(entities, transforms, physicals);
-        }
+        // incremental, so cheap enough to run every tick
+        spatial.update(entities, transforms, physicals);
     }
 }
@@ -71,44 +71,12 @@ impl From<Direction> for Rad {
     }
 }
 
-#[derive(Copy, Clone, Default, Ord, PartialOrd, Eq, PartialEq, Debug)]
-struct Desire(u8);
-
-impl Desire {
-    fn new(val: u8) -> Self {
-        Self(val)
-    }
-
-    /// (value, falloff value)
-    fn from_float(value: f32) -> (Desire, Desire) {
-        debug_assert!(
-            (0.0..=1.0).contains(&value),
-            "value out of range: {}",
-            value
-        );
-
-        let as_float = (value * (u8::MAX as f32)).ceil();
-        let desire = as_float as u8;
-        let falloff = (as_float * FALLOFF) as u8;
-
-        (Desire(desire), Desire(falloff))
-    }
-
-    fn zero(&mut self) {
-        self.0 = 0
-    }
-}
-
-impl From<Desire> for f32 {
-    fn from(desire: Desire) -> Self {
-        if desire.0 == 255 {
-            // special edge case
-            1.0
-        } else {
-            desire.0 as f32 / (u8::MAX as f32 + 1.0)
-        }
-    }
-}
+/// One f32 desire per direction bin. Aligned so the whole map fits in a single 256 bit
+/// vector register, and all per-bin kernels below are branchless fixed-length loops that
+/// the compiler vectorizes
+#[repr(align(32))]
+#[derive(Copy, Clone, Default)]
+struct Bins([f32; Direction::COUNT.as_usize()]);
 
 pub trait ContextType: Copy + Clone {}
 
@@ -127,7 +95,7 @@ const FALLOFF: f32 = 0.8;
 
 #[derive(Default, Copy, Clone)]
 pub struct SingleContextMap<C: ContextType> {
-    values: [Desire; Direction::COUNT.as_usize()],
+    values: Bins,
     phantom: PhantomData<C>,
 }
 
@@ -137,26 +105,39 @@ enum Falloff {
 }
 
 impl<C: ContextType> SingleContextMap<C> {
-    fn write_direct(&mut self, direction: Direction, desire: Desire) {
-        let val = &mut self.values[direction as usize];
+    fn write_direct(&mut self, direction: Direction, desire: f32) {
+        let val = &mut self.values.0[direction as usize];
         if desire > *val {
             *val = desire;
         }
     }
 
-    fn read_direct(self, direction: Direction) -> Desire {
-        self.values[direction as usize]
+    fn read_direct(self, direction: Direction) -> f32 {
+        self.values.0[direction as usize]
     }
 
     fn write(&mut self, direction: Rad, value: f32, do_falloff: Falloff) {
-        let dir = Direction::from(direction);
-        let (desire, falloff) = Desire::from_float(value);
-
-        self.values[dir as usize] = desire;
+        debug_assert!(
+            (0.0..=1.0).contains(&value),
+            "value out of range: {}",
+            value
+        );
 
-        if let Falloff::FallOff = do_falloff {
-            self.values[dir.prev() as usize] = falloff;
-            self.values[dir.next() as usize] = falloff;
+        let dir = Direction::from(direction);
+        let prev = dir.prev() as usize;
+        let next = dir.next() as usize;
+        let dir = dir as usize;
+
+        let falloff = value * FALLOFF;
+        let falloff_enabled = matches!(do_falloff, Falloff::FallOff) as u32 as f32;
+
+        // per-lane select instead of 3 scattered stores, so the whole map is written in
+        // one vectorized pass
+        for (i, v) in self.values.0.iter_mut().enumerate() {
+            let is_centre = (i == dir) as u32 as f32;
+            let is_neighbour = ((i == prev) | (i == next)) as u32 as f32 * falloff_enabled;
+            *v = is_centre * value + is_neighbour * falloff
+                + (1.0 - is_centre - is_neighbour) * *v;
         }
     }
 
@@ -193,30 +174,36 @@ impl ContextMap {
         self.danger.write_danger(direction, value);
     }
 
-    pub fn resolve(mut self) -> (Rad, f32) {
-        // find min danger
-        let min_danger = *self.danger.values.iter().min().unwrap();
-
-        // mask out higher dangers and the corresponding interests
-        self.danger
-            .values
-            .iter_mut()
-            .zip(self.interest.values.iter_mut())
-            .for_each(|(d, i)| {
-                if *d > min_danger {
-                    d.zero();
-                    i.zero();
-                }
-            });
+    pub fn resolve(self) -> (Rad, f32) {
+        let dangers = &self.danger.values.0;
+        let interests = &self.interest.values.0;
+
+        // find min danger, branchless reduction
+        let min_danger = dangers.iter().fold(f32::INFINITY, |min, d| min.min(*d));
+
+        // mask out interests in bins with higher danger in a single vectorized pass
+        let mut masked = [0.0f32; Direction::COUNT.as_usize()];
+        for i in 0..masked.len() {
+            let allowed = (dangers[i] <= min_danger) as u32 as f32;
+            masked[i] = interests[i] * allowed;
+        }
 
-        // choose highest interest
+        // choose highest interest. >= keeps the last of equal maxima, as position_max did
         // TODO follow gradients and choose continuous value
-        let best_direction = self.interest.values.iter().position_max().unwrap();
+        let (best_direction, desire) = masked
+            .iter()
+            .enumerate()
+            .fold((0, f32::NEG_INFINITY), |best, (i, v)| {
+                if *v >= best.1 {
+                    (i, *v)
+                } else {
+                    best
+                }
+            });
 
         let direction = Direction::from(best_direction as u8);
-        let desire = self.interest.values[best_direction];
 
-        (direction.into(), desire.into())
+        (direction.into(), desire)
     }
 
     pub fn interests_mut(&mut self) -> &mut InterestsContextMap {
@@ -231,7 +218,7 @@ mod tests {
 
     use common::*;
 
-    use crate::steer::context::{ContextMap, Desire, Direction, Interest, SingleContextMap};
+    use crate::steer::context::{ContextMap, Direction, Interest, SingleContextMap};
 
     #[test]
     fn direction_wrapping() {
@@ -245,30 +232,6 @@ mod tests {
         assert_eq!(Direction::South.prev(), Direction::SouthEast);
     }
 
-    #[test]
-    fn desire_conversion() {
-        // back and forth conversion should stay the same
-        for val in 0u8..=255 {
-            let desire = Desire::new(val);
-
-            let f: f32 = desire.into();
-            let (d, _) = Desire::from_float(f);
-
-            assert_eq!(desire, d, "{:?} -> {:?} & {:?}", desire, f, d);
-        }
-
-        for &val in &[0.0, 0.125, 0.25, 0.375, 0.5, 0.875, 1.0] {
-            let (desire, _) = Desire::from_float(val);
-            let float: f32 = desire.into();
-            assert!(
-                val.approx_eq(float, (EPSILON, 2)),
-                "{:?} != {:?}",
-                val,
-                float
-            );
-        }
-    }
-
     #[test]
     fn interest_only() {
         let mut map = ContextMap::default();
@@ -284,17 +247,19 @@ mod tests {
         let mut map = SingleContextMap::<Interest>::default();
         map.write_interest(rad(0.0), 0.5);
 
-        let expected_value = Desire(128);
-        assert_eq!(map.read_direct(Direction::North), expected_value);
+        let expected_value = 0.5;
+        assert!(map
+            .read_direct(Direction::North)
+            .approx_eq(expected_value, (EPSILON, 2)));
 
         let (a, b) = (
             map.read_direct(Direction::NorthWest),
             map.read_direct(Direction::NorthEast),
         );
-        assert!(a > Desire(0) && a < expected_value);
-        assert_eq!(a, b);
+        assert!(a > 0.0 && a < expected_value);
+        assert!(a.approx_eq(b, (EPSILON, 2)));
 
-        assert_eq!(map.read_direct(Direction::East), Desire(0));
-        assert_eq!(map.read_direct(Direction::West), Desire(0));
+        assert_eq!(map.read_direct(Direction::East), 0.0);
+        assert_eq!(map.read_direct(Direction::West), 0.0);
     }
 }
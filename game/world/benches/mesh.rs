@@ -0,0 +1,41 @@
+use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion};
+
+use common::*;
+use unit::world::{GlobalSliceIndex, CHUNK_SIZE};
+use world::block::BlockType;
+use world::helpers::load_single_chunk;
+use world::{make_simple_render_mesh_with_base, ChunkBuilder, SliceRange, UnresolvedVertex};
+
+pub fn mesh_generation(c: &mut Criterion) {
+    let mut group = c.benchmark_group("mesh generation");
+
+    for height in &[16i32, 64] {
+        let mut rng = common::seeded_rng(Some(6186321543));
+        let chunk = load_single_chunk(ChunkBuilder::new().fill_range(
+            (0, 0, 0),
+            (CHUNK_SIZE.as_i32() - 1, CHUNK_SIZE.as_i32() - 1, height - 1),
+            |_| match rng.gen_range(0i32, 3) {
+                0 => BlockType::Grass,
+                1 => BlockType::Stone,
+                _ => BlockType::Air,
+            },
+        ));
+
+        let terrain = chunk.terrain_snapshot();
+        let range = SliceRange::from_bounds(0, *height).expect("bad range");
+
+        group.bench_with_input(BenchmarkId::new("slice count", height), height, |b, _| {
+            b.iter(|| {
+                let mesh = make_simple_render_mesh_with_base::<UnresolvedVertex>(
+                    &terrain,
+                    range,
+                    GlobalSliceIndex::new(0),
+                );
+                black_box(mesh);
+            })
+        });
+    }
+}
+
+criterion_group!(benches, mesh_generation);
+criterion_main!(benches);
@@ -0,0 +1,46 @@
+use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion};
+
+use common::*;
+use world::helpers::world_from_source;
+use world::loader::MemoryTerrainSource;
+use world::presets;
+
+pub fn find_path(c: &mut Criterion) {
+    let presets = [
+        (
+            "multi chunk wonder",
+            presets::multi_chunk_wonder as fn() -> MemoryTerrainSource,
+        ),
+        ("flat lands", presets::flat_lands),
+        ("bottleneck", presets::bottleneck),
+        ("stairs", presets::stairs),
+    ];
+
+    let mut group = c.benchmark_group("find path");
+
+    for (name, source) in presets.iter() {
+        let world = world_from_source(source());
+        let w = world.borrow();
+
+        // generate endpoints up front so pathfinding is the only thing measured
+        let pairs = (0..100)
+            .filter_map(|_| {
+                let from = w.choose_random_walkable_block(50)?;
+                let to = w.choose_random_walkable_block(50)?;
+                Some((from, to))
+            })
+            .collect_vec();
+        assert!(!pairs.is_empty(), "no walkable blocks in {}", name);
+
+        group.bench_function(BenchmarkId::new("preset", name), |b| {
+            let mut pairs = pairs.iter().cycle();
+            b.iter(|| {
+                let (from, to) = *pairs.next().unwrap();
+                black_box(w.find_path(from, to))
+            })
+        });
+    }
+}
+
+criterion_group!(benches, find_path);
+criterion_main!(benches);
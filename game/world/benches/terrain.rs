@@ -1,12 +1,17 @@
+use std::convert::TryFrom;
+
 use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion};
 
 use common::*;
+use unit::world::BlockPosition;
 use unit::world::WorldPositionRange;
 use unit::world::CHUNK_SIZE;
 use world::block::BlockType;
-use world::helpers::{apply_updates, loader_from_chunks_blocking, world_from_chunks_blocking};
+use world::helpers::{
+    apply_updates, load_single_chunk, loader_from_chunks_blocking, world_from_chunks_blocking,
+};
 use world::loader::WorldTerrainUpdate;
-use world::{ChunkBuilder, ChunkDescriptor, DeepClone};
+use world::{BaseTerrain, ChunkBuilder, ChunkDescriptor, DeepClone};
 
 fn small_world_chunks(sz: i32) -> Vec<ChunkDescriptor> {
     let mut rand = thread_rng();
@@ -126,5 +131,49 @@ pub fn access_block(c: &mut Criterion) {
     });
 }
 
-criterion_group!(benches, small_world, tall_world, access_block);
+pub fn set_block(c: &mut Criterion) {
+    const HEIGHT: i32 = 64;
+
+    let mut chunk = load_single_chunk(ChunkBuilder::new().fill_range(
+        (0, 0, 0),
+        (CHUNK_SIZE.as_i32() - 1, CHUNK_SIZE.as_i32() - 1, HEIGHT - 1),
+        |_| BlockType::Stone,
+    ));
+
+    let mut rng = thread_rng();
+    let blocks: Vec<BlockPosition> = (0..1000)
+        .map(|_| {
+            BlockPosition::try_from((
+                rng.gen_range(0, CHUNK_SIZE.as_i32()),
+                rng.gen_range(0, CHUNK_SIZE.as_i32()),
+                rng.gen_range(0, HEIGHT),
+            ))
+            .expect("bad position")
+        })
+        .collect();
+
+    let mut group = c.benchmark_group("set block");
+
+    // slabs are uniquely owned after the first write, so writes mutate in place
+    group.bench_function("owned slabs", |b| {
+        let mut positions = blocks.iter().cycle();
+        b.iter(|| {
+            let pos = *positions.next().unwrap();
+            black_box(chunk.raw_terrain_mut().try_set_block(pos, BlockType::Grass));
+        })
+    });
+
+    // a fresh snapshot shares every slab, so each write must copy its slab first
+    group.bench_function("copy on write churn", |b| {
+        let mut positions = blocks.iter().cycle();
+        b.iter(|| {
+            let snapshot = chunk.terrain_snapshot();
+            let pos = *positions.next().unwrap();
+            black_box(chunk.raw_terrain_mut().try_set_block(pos, BlockType::Grass));
+            drop(snapshot);
+        })
+    });
+}
+
+criterion_group!(benches, small_world, tall_world, access_block, set_block);
 criterion_main!(benches);
@@ -7,7 +7,7 @@ use unit::world::{
 
 use crate::chunk::slab::Slab;
 use crate::chunk::slice::{Slice, SliceOwned};
-use crate::chunk::terrain::RawChunkTerrain;
+use crate::chunk::terrain::{ChunkTerrainSnapshot, RawChunkTerrain};
 use crate::chunk::BaseTerrain;
 use crate::navigation::{BlockGraph, ChunkArea, WorldArea};
 use crate::world::LoadNotifier;
@@ -111,10 +111,6 @@ impl<C: WorldContext> Chunk<C> {
         self.areas.keys()
     }
 
-    pub(crate) fn area_count(&self) -> usize {
-        self.areas.len()
-    }
-
     pub(crate) fn remove_block_graphs(&mut self, (min, max): (SlabIndex, SlabIndex)) {
         let n = self.areas.len();
         self.areas
@@ -154,6 +150,11 @@ impl<C: WorldContext> Chunk<C> {
         self.slice(slice).unwrap_or_else(|| Slice::dummy())
     }
 
+    /// Cheap arc-clone copy of the terrain for reading on another thread
+    pub fn terrain_snapshot(&self) -> ChunkTerrainSnapshot {
+        self.terrain.snapshot()
+    }
+
     pub fn associated_block_data(&self, pos: BlockPosition) -> Option<&C::AssociatedBlockData> {
         self.block_data.get(&pos)
     }
@@ -342,6 +343,12 @@ impl<C: WorldContext> Chunk<C> {
     pub fn has_slab(&self, slab: SlabIndex) -> bool {
         self.terrain.slab(slab).is_some()
     }
+
+    /// The slab has been requested, is in progress or is already loaded, i.e. there is no
+    /// point generating it speculatively
+    pub(crate) fn is_slab_requested_or_loaded(&self, slab: SlabIndex) -> bool {
+        !matches!(self.slab_progress(slab), SlabLoadingStatus::Unloaded)
+    }
 }
 
 impl<C: WorldContext> BaseTerrain for Chunk<C> {
@@ -2,7 +2,9 @@ pub use slab::DeepClone;
 
 pub use self::builder::{ChunkBuilder, ChunkDescriptor};
 pub use self::chunk::{Chunk, ChunkId};
-pub use self::terrain::{BaseTerrain, BlockDamageResult, OcclusionChunkUpdate};
+pub use self::terrain::{
+    BaseTerrain, BlockDamageResult, ChunkTerrainSnapshot, OcclusionChunkUpdate,
+};
 pub(crate) use self::terrain::{RawChunkTerrain, WhichChunk};
 
 mod builder;
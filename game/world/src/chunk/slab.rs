@@ -1,3 +1,4 @@
+use std::collections::HashMap;
 use std::iter::once;
 use std::ops::Deref;
 
@@ -5,12 +6,12 @@ use common::*;
 use unit::world::CHUNK_SIZE;
 use unit::world::{LocalSliceIndex, SlabIndex, SlabLocation, SlabPosition, WorldRange, SLAB_SIZE};
 
-use crate::block::Block;
+use crate::block::{Block, BlockType};
 use crate::chunk::slice::{unflatten_index, Slice, SliceMut, SliceOwned};
 use crate::loader::{GenericTerrainUpdate, SlabTerrainUpdate};
 use crate::navigation::discovery::AreaDiscovery;
 use crate::navigation::{BlockGraph, ChunkArea};
-use crate::occlusion::{BlockOcclusion, NeighbourOpacity};
+use crate::occlusion::{BlockOcclusion, NeighbourOpacity, SliceSolidity};
 use crate::WorldChangeEvent;
 use grid::{grid_declare, Grid, GridImpl};
 use std::sync::Arc;
@@ -33,6 +34,42 @@ pub enum SlabType {
 #[derive(Clone)]
 pub struct Slab(Arc<SlabGridImpl>, SlabType);
 
+lazy_static! {
+    /// Canonical all-air slab storage shared by every empty slab and placeholder, so they cost a
+    /// single allocation planet-wide. A full per-slab palette with bit-packed indices doesn't fit
+    /// while `Block` holds per-voxel occlusion and area state behind `&[Block]` borrows, but
+    /// uniform slabs are the overwhelming majority so this captures most of the win. Mutation
+    /// expands the slab into its own allocation via the existing CoW machinery
+    static ref CANONICAL_AIR: Arc<SlabGridImpl> = Arc::from(SlabGridImpl::default_boxed());
+
+    /// Global intern table of canonical homogeneous slabs of other block types (all-stone,
+    /// all-water etc), lazily populated as generation produces them
+    static ref CANONICAL_UNIFORM: parking_lot::RwLock<HashMap<BlockType, Arc<SlabGridImpl>>> =
+        parking_lot::RwLock::new(HashMap::new());
+}
+
+/// Shared storage for a slab uniformly filled with the given block type, interning it on first
+/// use
+fn canonical_grid(block_type: BlockType) -> Arc<SlabGridImpl> {
+    if let BlockType::Air = block_type {
+        return Arc::clone(&CANONICAL_AIR);
+    }
+
+    if let Some(interned) = CANONICAL_UNIFORM.read().get(&block_type) {
+        return Arc::clone(interned);
+    }
+
+    let mut interned = CANONICAL_UNIFORM.write();
+    Arc::clone(interned.entry(block_type).or_insert_with(|| {
+        debug!("interning canonical uniform slab"; "block_type" => ?block_type);
+        let mut grid = SlabGridImpl::default_boxed();
+        grid.array_mut()
+            .iter_mut()
+            .for_each(|b| *b = Block::with_block_type(block_type));
+        Arc::from(grid)
+    }))
+}
+
 #[derive(Default)]
 pub(crate) struct SlabInternalNavigability(Vec<(ChunkArea, BlockGraph)>);
 
@@ -50,13 +87,13 @@ impl Slab {
     }
 
     fn new_empty(ty: SlabType) -> Self {
-        Self::from_grid(SlabGrid::default(), ty)
+        // all empty slabs share the same canonical storage until mutated
+        Self(Arc::clone(&CANONICAL_AIR), ty)
     }
 
     pub fn from_grid(grid: SlabGrid, ty: SlabType) -> Self {
         let terrain = grid.into_boxed_impl();
-        let arc = Arc::from(terrain);
-        Self(arc, ty)
+        Self::from_boxed_grid(terrain, ty)
     }
 
     pub fn from_other_grid<I, G>(other: Grid<G>, ty: SlabType) -> Self
@@ -66,8 +103,15 @@ impl Slab {
     {
         let new_vals = other.array().iter().map(|item| item.into());
         let terrain = SlabGridImpl::from_iter(new_vals);
-        let arc = Arc::from(terrain);
-        Self(arc, ty)
+        Self::from_boxed_grid(terrain, ty)
+    }
+
+    fn from_boxed_grid(terrain: Box<SlabGridImpl>, ty: SlabType) -> Self {
+        // swap freshly generated homogeneous slabs for the interned canonical copy
+        match uniform_block_type(&terrain) {
+            Some(block_type) => Self(canonical_grid(block_type), ty),
+            None => Self(Arc::from(terrain), ty),
+        }
     }
 
     pub fn cow_clone(&mut self) -> &mut Slab {
@@ -76,6 +120,13 @@ impl Slab {
     }
 
     pub fn expect_mut(&mut self) -> &mut SlabGridImpl {
+        if !self.is_exclusive() && self.is_shared_canonical() {
+            // expand shared uniform storage into this slab's own allocation - expected, unlike
+            // an accidental copy of a normal slab
+            trace!("expanding canonical uniform slab for mutation");
+            let _ = Arc::make_mut(&mut self.0);
+        }
+
         let grid = Arc::get_mut(&mut self.0).expect("expected to be the only slab reference");
 
         if let SlabType::Placeholder = std::mem::replace(&mut self.1, SlabType::Normal) {
@@ -98,6 +149,21 @@ impl Slab {
         matches!(self.1, SlabType::Placeholder)
     }
 
+    /// Shares some canonical uniform storage i.e. has never been mutated
+    fn is_shared_canonical(&self) -> bool {
+        Arc::ptr_eq(&self.0, &CANONICAL_AIR)
+            || CANONICAL_UNIFORM
+                .read()
+                .values()
+                .any(|interned| Arc::ptr_eq(&self.0, interned))
+    }
+
+    /// Cheap check that this is *definitely* all air - a false negative is possible for a slab
+    /// that was mutated into all-air, which is fine for skipping work
+    pub fn is_all_air(&self) -> bool {
+        Arc::ptr_eq(&self.0, &CANONICAL_AIR)
+    }
+
     /// Leaks
     #[cfg(test)]
     pub fn raw(&self) -> *const SlabGridImpl {
@@ -171,6 +237,18 @@ impl IntoIterator for SlabInternalNavigability {
     }
 }
 
+/// All blocks the same type with no per-block state yet, i.e. fresh out of generation. Slabs
+/// that were mutated into uniformity are not detected, which only costs the shared allocation
+fn uniform_block_type(grid: &SlabGridImpl) -> Option<BlockType> {
+    let blocks = grid.array();
+    let first = blocks[0].block_type();
+    blocks
+        .iter()
+        .skip(1)
+        .all(|b| b.block_type() == first)
+        .as_some(first)
+}
+
 /// Initialization functions
 impl Slab {
     /// Discover navigability and occlusion
@@ -182,14 +260,28 @@ impl Slab {
     ) -> SlabInternalNavigability {
         log_scope!(o!(index));
 
-        // TODO detect when slab is all air and avoid expensive processing
-        // but remember an all air slab above a solid slab DOES have an area on the first slice..
+        // remember an all air slab above a solid slab DOES have an area on the first slice, so
+        // navigation discovery can't be skipped
 
         // flood fill to discover navigability
+        let all_air = self.is_all_air();
         let navigation = self.discover_areas(index, below.map(Into::into));
 
-        // occlusion
-        self.init_occlusion(above.map(Into::into));
+        // occlusion - nothing to do if all air, as only solid blocks occlude. a canonical
+        // uniform solid slab can only develop occlusion from a transparent block in the slice
+        // above, so avoid expanding it when there is none
+        if !all_air {
+            let above = above.map(Into::into);
+            let skip = self.is_shared_canonical()
+                && above
+                    .as_ref()
+                    .map(|s: &Slice| s.slice().iter().all(|b| b.opacity().solid()))
+                    .unwrap_or(true);
+
+            if !skip {
+                self.init_occlusion(above);
+            }
+        }
 
         navigation
     }
@@ -199,8 +291,10 @@ impl Slab {
         this_slab: SlabIndex,
         slice_below: Option<Slice>,
     ) -> SlabInternalNavigability {
-        // TODO if exclusive we're in deep water with CoW
-        assert!(self.is_exclusive(), "not exclusive?");
+        assert!(
+            self.is_exclusive() || self.is_shared_canonical(),
+            "not exclusive?"
+        );
 
         // collect slab into local grid
         let mut discovery = AreaDiscovery::from_slab(&self.0, this_slab, slice_below);
@@ -214,23 +308,29 @@ impl Slab {
 
         // TODO discover internal area links
 
-        // apply areas to blocks
-        discovery.apply(self.expect_mut());
+        // apply areas to blocks, skipping the write (and possible expansion of shared uniform
+        // storage) if there are none
+        if area_count > 0 {
+            discovery.apply(self.expect_mut());
+        }
 
         SlabInternalNavigability(slab_areas)
     }
 
     fn init_occlusion(&mut self, slice_above: Option<Slice>) {
         self.ascending_slice_pairs(slice_above, |mut slice_this, slice_next| {
+            // packed solidity of the slice above, sampled repeatedly for both the
+            // directly-above check and each solid block's neighbours
+            let above_solidity = SliceSolidity::new(slice_next);
+
             slice_this.iter_mut().enumerate().for_each(|(i, b)| {
                 let this_block = b.opacity();
-                let block_above = (*slice_next)[i].opacity();
 
                 // this block should be solid and the one above it should not be
-                let opacity = if this_block.solid() && block_above.transparent() {
+                let opacity = if this_block.solid() && !above_solidity.is_solid_index(i) {
                     let this_block = unflatten_index(i);
 
-                    NeighbourOpacity::with_slice_above(this_block, slice_next)
+                    NeighbourOpacity::with_cached_slice_above(this_block, &above_solidity)
                 } else {
                     NeighbourOpacity::default()
                 };
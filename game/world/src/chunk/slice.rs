@@ -210,7 +210,7 @@ pub fn unflatten_index(index: usize) -> SliceBlock {
     )
 }
 
-fn flatten_coords(block: SliceBlock) -> usize {
+pub(crate) fn flatten_coords(block: SliceBlock) -> usize {
     let (x, y) = block.xy();
     ((y * CHUNK_SIZE.as_block_coord()) + x) as usize
 }
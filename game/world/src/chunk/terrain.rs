@@ -26,6 +26,29 @@ pub struct RawChunkTerrain {
     slabs: DoubleSidedVec<Slab>,
 }
 
+/// Cheap copy of a chunk's terrain for reading off the main thread, e.g. mesh generation
+/// on a worker. Slab contents are behind arcs so this only clones a pointer per slab, and
+/// copy-on-write means later terrain edits don't affect the snapshot
+pub struct ChunkTerrainSnapshot {
+    /// Ascending by slab index
+    slabs: Vec<(SlabIndex, Slab)>,
+}
+
+impl ChunkTerrainSnapshot {
+    pub fn slice(&self, index: GlobalSliceIndex) -> Option<Slice> {
+        let slab_idx = index.slab_index();
+        self.slabs
+            .binary_search_by_key(&slab_idx, |(idx, _)| *idx)
+            .ok()
+            .map(|i| self.slabs[i].1.slice(index.to_local()))
+    }
+
+    pub fn slice_or_dummy(&self, index: GlobalSliceIndex) -> Slice {
+        #[allow(clippy::redundant_closure)]
+        self.slice(index).unwrap_or_else(|| Slice::dummy())
+    }
+}
+
 pub trait BaseTerrain {
     fn raw_terrain(&self) -> &RawChunkTerrain;
     fn raw_terrain_mut(&mut self) -> &mut RawChunkTerrain;
@@ -168,6 +191,15 @@ impl RawChunkTerrain {
             .map(|(ptr, idx)| (ptr, SlabIndex(idx)))
     }
 
+    pub(crate) fn snapshot(&self) -> ChunkTerrainSnapshot {
+        ChunkTerrainSnapshot {
+            slabs: self
+                .slabs_from_bottom()
+                .map(|(slab, idx)| (idx, slab.clone()))
+                .collect(),
+        }
+    }
+
     /// Adds slab, returning old if it exists
     pub fn replace_slab(&mut self, index: SlabIndex, new_slab: Slab) -> Option<Slab> {
         if let Some(old) = self.slabs.get_mut(index) {
@@ -699,7 +731,7 @@ mod pair_walking {
 
         if opacity.solid() {
             let mut opacities = NeighbourOpacity::default();
-            opacities[direction as usize] = opacity.into();
+            opacities.set(direction as usize, opacity.into());
 
             // get block pos in this chunk
             let block_pos = {
@@ -798,14 +830,14 @@ mod pair_walking {
             let mut opacities = NeighbourOpacity::default();
 
             // directly across is certainly present
-            opacities[direction as usize] = upper[centre.unwrap()].opacity().into();
+            opacities.set(direction as usize, upper[centre.unwrap()].opacity().into());
 
             if let Some(left) = left {
-                opacities[direction.next() as usize] = upper[left].opacity().into();
+                opacities.set(direction.next() as usize, upper[left].opacity().into());
             }
 
             if let Some(right) = right {
-                opacities[direction.prev() as usize] = upper[right].opacity().into();
+                opacities.set(direction.prev() as usize, upper[right].opacity().into());
             }
 
             // get block pos in this chunk
@@ -4,11 +4,13 @@
 pub use petgraph::prelude::NodeIndex;
 
 pub use self::chunk::{
-    BaseTerrain, BlockDamageResult, Chunk, ChunkBuilder, ChunkDescriptor, DeepClone,
-    OcclusionChunkUpdate,
+    BaseTerrain, BlockDamageResult, Chunk, ChunkBuilder, ChunkDescriptor, ChunkTerrainSnapshot,
+    DeepClone, OcclusionChunkUpdate,
+};
+pub use self::mesh::{make_simple_render_mesh_with_base, BaseVertex, UnresolvedVertex};
+pub use self::navigation::{
+    EdgeCost, FlowField, NavigationError, SearchGoal, WorldArea, WorldPath,
 };
-pub use self::mesh::BaseVertex;
-pub use self::navigation::{EdgeCost, NavigationError, SearchGoal, WorldArea, WorldPath};
 pub use self::viewer::{SliceRange, WorldViewer};
 pub use self::world::{helpers, World, WorldChangeEvent, WorldContext};
 pub use self::world_ref::{InnerWorldRef, InnerWorldRefMut, WorldRef};
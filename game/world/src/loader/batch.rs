@@ -124,6 +124,11 @@ impl<U> UpdateBatcher<U> {
         let (batch, items) = self.batches.remove(&batch).expect("invalid batch");
         (batch, items)
     }
+
+    /// Number of submitted items still waiting on the rest of their batch
+    pub fn queued_items(&self) -> usize {
+        self.batches.values().map(|(_, items)| items.len()).sum()
+    }
 }
 
 impl<U> Default for UpdateBatcher<U> {
@@ -15,6 +15,17 @@ use unit::world::{ChunkLocation, SlabIndex};
 
 const SEND_FAILURE_THRESHOLD: usize = 20;
 
+declare_histogram_metric!(
+    SLAB_FINALIZE_SECONDS,
+    "slab_finalize_seconds",
+    "Time spent finalizing a completed batch of loaded slabs"
+);
+declare_gauge_metric!(
+    SLAB_FINALIZE_QUEUED,
+    "slab_finalize_queued",
+    "Loaded slabs waiting on the rest of their batch before finalization"
+);
+
 pub struct SlabFinalizer<C: WorldContext> {
     world: WorldRef<C>,
     updates: async_channel::UnboundedSender<OcclusionChunkUpdate>,
@@ -49,6 +60,9 @@ impl<C: WorldContext> SlabFinalizer<C> {
         for (batch_id, batch_size) in self.batcher.complete_batches() {
             trace!("popping batch"; "id" => batch_id, "size" => batch_size);
 
+            #[cfg(feature = "metrics")]
+            let start = std::time::Instant::now();
+
             // we know that all dependent slabs and chunks (those in the same batch) are present now
             let (batch, mut items) = self.batcher.pop_batch(batch_id);
             debug_assert_eq!(items.len(), batch_size);
@@ -95,7 +109,13 @@ impl<C: WorldContext> SlabFinalizer<C> {
                 log_scope!(o!(chunk));
                 self.finalize_chunk_between_slabs(chunk, slab_range).await;
             }
+
+            #[cfg(feature = "metrics")]
+            histogram_metric!(SLAB_FINALIZE_SECONDS, start.elapsed().as_secs_f64());
         }
+
+        #[cfg(feature = "metrics")]
+        gauge_metric!(SLAB_FINALIZE_QUEUED, self.batcher.queued_items());
     }
 
     /// Lower and upper slab range is inclusive
@@ -7,9 +7,12 @@ use unit::world::{ChunkLocation, GlobalSliceIndex, SlabIndex, SlabLocation, Worl
 use crate::chunk::slab::{Slab, SlabInternalNavigability, SlabType};
 
 use crate::loader::batch::UpdateBatchUniqueId;
-use crate::loader::worker_pool::LoadTerrainResult;
+use crate::loader::worker_pool::{LoadTerrainResult, WorkerHandle};
+use crate::navigation::WorldArea;
 use crate::world::{ContiguousChunkIterator, WorldChangeEvent};
-use crate::{OcclusionChunkUpdate, WorldContext, WorldRef};
+use crate::{
+    NavigationError, OcclusionChunkUpdate, SearchGoal, WorldContext, WorldPath, WorldRef,
+};
 
 use crate::loader::terrain_source::BlockDetails;
 use crate::loader::{
@@ -17,19 +20,106 @@ use crate::loader::{
 };
 use crate::world::slab_loading::SlabProcessingFuture;
 use futures::FutureExt;
-use std::collections::HashSet;
+use parking_lot::Mutex;
+use std::collections::{HashMap, HashSet};
 use std::iter::repeat;
+use std::sync::Arc;
+
+declare_histogram_metric!(
+    TERRAIN_UPDATES_SECONDS,
+    "terrain_updates_seconds",
+    "Time spent applying a tick's terrain updates"
+);
+declare_gauge_metric!(
+    TERRAIN_UPDATES_DEFERRED,
+    "terrain_updates_deferred",
+    "Terrain updates held back to a later tick because their slab is loading"
+);
 
 pub struct WorldLoader<C: WorldContext> {
     source: TerrainSource,
     pool: AsyncWorkerPool,
     finalization_channel: async_channel::Sender<LoadTerrainResult>,
     chunk_updates_rx: async_channel::UnboundedReceiver<OcclusionChunkUpdate>,
+    path_results_tx: async_channel::UnboundedSender<PathRequestResult>,
+    path_results_rx: async_channel::UnboundedReceiver<PathRequestResult>,
     world: WorldRef<C>,
     last_batch_size: usize,
     batch_ids: UpdateBatchUniqueId,
+    slab_requests: Arc<SlabRequestQueue>,
+}
+
+/// Slab loads waiting to be picked up by a pool worker. Drained in order of distance
+/// from the viewer centre rather than FIFO, so the slabs under the camera finalize
+/// first. The centre can be updated while loads are in flight to reorder whatever
+/// hasn't started yet
+#[derive(Default)]
+struct SlabRequestQueue {
+    entries: Mutex<Vec<QueuedSlabLoad>>,
+
+    /// Last known viewer centre, None until the viewer reports one
+    viewer_centre: Mutex<Option<SlabLocation>>,
+}
+
+struct QueuedSlabLoad {
+    slab: SlabLocation,
+    slab_type: SlabType,
+    batch: UpdateBatch,
+}
+
+impl SlabRequestQueue {
+    fn push(&self, load: QueuedSlabLoad) {
+        self.entries.lock().push(load);
+    }
+
+    /// The queued load currently nearest the viewer centre, or FIFO if no centre has
+    /// been reported yet
+    fn pop_nearest(&self) -> Option<QueuedSlabLoad> {
+        let mut entries = self.entries.lock();
+
+        let idx = match *self.viewer_centre.lock() {
+            Some(centre) => entries
+                .iter()
+                .position_min_by_key(|load| Self::distance_key(load.slab, centre))?,
+            None => {
+                if entries.is_empty() {
+                    return None;
+                }
+                0
+            }
+        };
+
+        Some(entries.remove(idx))
+    }
+
+    fn set_viewer_centre(&self, centre: SlabLocation) {
+        *self.viewer_centre.lock() = Some(centre);
+    }
+
+    /// Manhattan distance in chunks plus vertical distance in slabs
+    fn distance_key(slab: SlabLocation, centre: SlabLocation) -> i32 {
+        let dx = slab.chunk.0 - centre.chunk.0;
+        let dy = slab.chunk.1 - centre.chunk.1;
+        let dz = slab.slab.as_i32() - centre.slab.as_i32();
+        dx.abs() + dy.abs() + dz.abs()
+    }
 }
 
+/// Opaque caller-provided id to match async path results up with their requests
+#[derive(Debug, Copy, Clone, Eq, PartialEq, Hash)]
+pub struct PathRequestId(pub u64);
+
+/// A path search to run asynchronously on the worker pool
+#[derive(Debug)]
+pub struct PathRequest {
+    pub id: PathRequestId,
+    pub from: WorldPosition,
+    pub to: WorldPosition,
+    pub goal: SearchGoal,
+}
+
+type PathRequestResult = (PathRequestId, Result<WorldPath, NavigationError>);
+
 pub struct LoadedSlab {
     pub(crate) slab: SlabLocation,
     /// If None the terrain has already been updated
@@ -54,6 +144,7 @@ impl<C: WorldContext> WorldLoader<C> {
     pub fn new<S: Into<TerrainSource>>(source: S, mut pool: AsyncWorkerPool) -> Self {
         let (finalize_tx, finalize_rx) = async_channel::channel(16);
         let (chunk_updates_tx, chunk_updates_rx) = async_channel::unbounded();
+        let (path_results_tx, path_results_rx) = async_channel::unbounded();
 
         let world = WorldRef::default();
         pool.start_finalizer(world.clone(), finalize_rx, chunk_updates_tx);
@@ -63,9 +154,12 @@ impl<C: WorldContext> WorldLoader<C> {
             pool,
             finalization_channel: finalize_tx,
             chunk_updates_rx,
+            path_results_tx,
+            path_results_rx,
             world,
             last_batch_size: 0,
             batch_ids: UpdateBatchUniqueId::default(),
+            slab_requests: Arc::new(SlabRequestQueue::default()),
         }
     }
 
@@ -73,6 +167,11 @@ impl<C: WorldContext> WorldLoader<C> {
         self.world.clone()
     }
 
+    /// For spawning standalone tasks (e.g. mesh generation) on the worker pool
+    pub fn worker_handle(&self) -> WorkerHandle {
+        self.pool.handle()
+    }
+
     /// Requests slabs as a single batch. Must be sorted as per [self.request_slabs_with_count]
     pub fn request_slabs(&mut self, slabs: impl ExactSizeIterator<Item = SlabLocation> + Clone) {
         let count = slabs.len();
@@ -146,6 +245,7 @@ impl<C: WorldContext> WorldLoader<C> {
         let mut batches = UpdateBatch::builder(&mut self.batch_ids, count);
         let mut real_count = 0;
 
+        let slabs_for_prefetch = slabs.clone();
         let all_slabs = {
             let real_slabs = slabs.zip(repeat(SlabType::Normal));
             let air_slabs = extra_slabs.into_iter().zip(repeat(SlabType::Placeholder));
@@ -167,14 +267,33 @@ impl<C: WorldContext> WorldLoader<C> {
             let batch = batches.next_batch();
 
             debug!(
-                "submitting slab to pool as part of batch";
+                "queueing slab for pool as part of batch";
                 slab, batch
             );
 
+            // queue instead of handing straight to a worker, so loads start in
+            // viewer-distance order rather than iteration order
+            self.slab_requests.push(QueuedSlabLoad {
+                slab,
+                slab_type,
+                batch,
+            });
+
             // load raw terrain and do as much processing in isolation as possible on a worker thread
             let world = self.world();
+            let requests = self.slab_requests.clone();
             self.pool.submit_async(
                 async move {
+                    // not necessarily the slab queued above - each worker takes whichever
+                    // queued load is nearest the viewer when it starts
+                    let QueuedSlabLoad {
+                        slab,
+                        slab_type,
+                        batch,
+                    } = requests
+                        .pop_nearest()
+                        .expect("slab request queue should not be empty");
+
                     let result = if let SlabType::Placeholder = slab_type {
                         // empty placeholder
                         Ok(None)
@@ -232,6 +351,53 @@ impl<C: WorldContext> WorldLoader<C> {
         );
 
         self.last_batch_size = count;
+
+        // speculatively generate a ring of slabs around the requested batch on the pool
+        // behind the real loads, so steady movement in one direction finds the next
+        // batch already generated. every requested slab was marked above, so only truly
+        // unknown neighbours are submitted
+        // no prefetch when config isn't initialized, e.g. in tests
+        let radius = if config::is_initialized() {
+            config::get().world.slab_prefetch_radius as i32
+        } else {
+            0
+        };
+        if radius > 0 && matches!(self.source, TerrainSource::Generated(_)) {
+            let ring = slabs_for_prefetch
+                .flat_map(|slab| {
+                    (-radius..=radius)
+                        .cartesian_product(-radius..=radius)
+                        .cartesian_product(-radius..=radius)
+                        .filter(|&((dx, dy), dz)| (dx, dy, dz) != (0, 0, 0))
+                        .map(move |((dx, dy), dz)| {
+                            SlabLocation::new(slab.slab + dz, slab.chunk + (dx, dy))
+                        })
+                })
+                .collect::<HashSet<_>>();
+
+            for candidate in ring {
+                let known = world_mut
+                    .find_chunk_with_pos(candidate.chunk)
+                    .map(|chunk| chunk.is_slab_requested_or_loaded(candidate.slab))
+                    .unwrap_or(false);
+
+                if known {
+                    continue;
+                }
+
+                let source = self.source.clone();
+                self.pool.submit_any_async_with_handle(async move {
+                    source.prefetch_slab(candidate).await;
+                });
+            }
+        }
+    }
+
+    /// Updates the viewer centre used to prioritize queued slab loads. Requests still
+    /// waiting for a worker are reordered by their distance to the new centre, rather
+    /// than being drained in the order they were submitted
+    pub fn update_viewer_priority(&self, centre: SlabLocation) {
+        self.slab_requests.set_viewer_centre(centre);
     }
 
     /// Note changes are made immediately to the terrain but are not immediate to the player,
@@ -241,6 +407,9 @@ impl<C: WorldContext> WorldLoader<C> {
         terrain_updates: &mut HashSet<WorldTerrainUpdate>,
         changes_out: &mut Vec<WorldChangeEvent>,
     ) {
+        #[cfg(feature = "metrics")]
+        let start = Instant::now();
+
         let world_ref = self.world.clone();
 
         let (slab_updates, upper_slab_limit) = {
@@ -334,6 +503,11 @@ impl<C: WorldContext> WorldLoader<C> {
 
         if upper_slab_limit == 0 {
             // nothing to do
+            #[cfg(feature = "metrics")]
+            {
+                histogram_metric!(TERRAIN_UPDATES_SECONDS, start.elapsed().as_secs_f64());
+                gauge_metric!(TERRAIN_UPDATES_DEFERRED, terrain_updates.len());
+            }
             return;
         }
 
@@ -398,6 +572,12 @@ impl<C: WorldContext> WorldLoader<C> {
         }
 
         self.last_batch_size = real_slab_count;
+
+        #[cfg(feature = "metrics")]
+        {
+            histogram_metric!(TERRAIN_UPDATES_SECONDS, start.elapsed().as_secs_f64());
+            gauge_metric!(TERRAIN_UPDATES_DEFERRED, terrain_updates.len());
+        }
     }
 
     pub fn block_on_next_finalization(
@@ -465,6 +645,88 @@ impl<C: WorldContext> WorldLoader<C> {
         }
     }
 
+    /// Submits a batch of path searches to run on the worker pool against a read-locked
+    /// snapshot of the world, in parallel per unique area-level query - identical
+    /// area-level queries within the batch share a single area search. Results are
+    /// consumed via [Self::iter_path_results] on a later tick
+    pub fn request_paths(&mut self, requests: impl Iterator<Item = PathRequest>) {
+        // TODO reuse buf
+        type ResolvedRequest = (PathRequestId, WorldPosition, WorldPosition, SearchGoal);
+        let mut groups: HashMap<(WorldArea, WorldArea), Vec<ResolvedRequest>> = HashMap::new();
+
+        {
+            // resolve endpoints up front so identical area-level queries can be coalesced.
+            // this also answers trivial and doomed requests without touching the pool
+            let world = self.world.borrow();
+            for req in requests {
+                let result = match world.resolve_path_endpoints(req.from, req.to, req.goal) {
+                    Err(err) => Err(err),
+                    Ok((from, to, _)) if from == to => Ok(WorldPath::new(Vec::new(), to)),
+                    Ok((from, to, goal)) => {
+                        match (world.area(from).ok(), world.area(to).ok()) {
+                            (Some(from_area), Some(to_area)) => {
+                                groups
+                                    .entry((from_area, to_area))
+                                    .or_insert_with(Vec::new)
+                                    .push((req.id, from, to, goal));
+                                continue;
+                            }
+                            (None, _) => Err(NavigationError::SourceNotWalkable(from)),
+                            (_, None) => Err(NavigationError::TargetNotWalkable(to)),
+                        }
+                    }
+                };
+
+                self.send_path_result(req.id, result);
+            }
+        }
+
+        debug!(
+            "submitting {queries} unique area queries for path requests",
+            queries = groups.len()
+        );
+
+        for ((from_area, to_area), group) in groups.into_iter() {
+            let world_ref = self.world.clone();
+            let results_tx = self.path_results_tx.clone();
+
+            self.pool.submit_any_async_with_handle(async move {
+                let world = world_ref.borrow();
+
+                // area-level search is shared by the whole group
+                let area_path = world.find_area_path_between(from_area, to_area);
+
+                for (id, from, to, goal) in group.into_iter() {
+                    let result = match &area_path {
+                        Ok(area_path) => world.expand_area_path(from, to, goal, area_path),
+                        Err(err) => Err(err.clone()),
+                    };
+
+                    if results_tx.unbounded_send((id, result)).is_err() {
+                        warn!("failed to send path result"; "request" => ?id);
+                    }
+                }
+            });
+        }
+    }
+
+    /// Drains results of path searches submitted via [Self::request_paths] that have
+    /// completed so far
+    pub fn iter_path_results(
+        &mut self,
+        mut f: impl FnMut(PathRequestId, Result<WorldPath, NavigationError>),
+    ) {
+        while let Ok(Some((id, result))) = self.path_results_rx.try_next() {
+            f(id, result)
+        }
+    }
+
+    fn send_path_result(&self, id: PathRequestId, result: Result<WorldPath, NavigationError>) {
+        if self.path_results_tx.unbounded_send((id, result)).is_err() {
+            warn!("failed to send path result"; "request" => ?id);
+        }
+    }
+
     pub fn get_ground_level(
         &self,
         block: WorldPosition,
@@ -1,11 +1,11 @@
 pub use batch::UpdateBatch;
-pub use loading::{BlockForAllError, LoadedSlab, WorldLoader};
+pub use loading::{BlockForAllError, LoadedSlab, PathRequest, PathRequestId, WorldLoader};
 pub use procgen::PlanetParams;
 pub use terrain_source::{
     BlockDetails, GeneratedTerrainSource, MemoryTerrainSource, TerrainSource, TerrainSourceError,
 };
 pub use update::{GenericTerrainUpdate, SlabTerrainUpdate, TerrainUpdatesRes, WorldTerrainUpdate};
-pub use worker_pool::AsyncWorkerPool;
+pub use worker_pool::{AsyncWorkerPool, WorkerHandle};
 
 mod batch;
 mod finalizer;
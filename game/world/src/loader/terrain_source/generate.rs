@@ -9,10 +9,30 @@ use procgen::{GeneratedBlock, Planet, PlanetParamsRef};
 
 use unit::world::{GlobalSliceIndex, SlabLocation, WorldPosition};
 
+use parking_lot::Mutex;
+use std::collections::hash_map::Entry;
+use std::collections::HashMap;
+use std::sync::Arc;
+
 /// Holds lightweight arc'd and mutex'd reference to planet
 #[derive(Clone)]
 pub struct GeneratedTerrainSource {
     planet: Planet,
+
+    /// Slabs generated speculatively before being requested, taken by the real request
+    prefetched: Arc<Mutex<HashMap<SlabLocation, PrefetchedSlab>>>,
+}
+
+/// State of a speculatively generated slab
+enum PrefetchedSlab {
+    /// Generation is running on a worker
+    InFlight,
+
+    /// Terrain is ready to be taken by the real request
+    Ready(Slab),
+
+    /// The real request overtook the prefetch, which should discard its result
+    Taken,
 }
 
 impl GeneratedTerrainSource {
@@ -21,7 +41,10 @@ impl GeneratedTerrainSource {
 
         planet.initial_generation().await?;
 
-        Ok(Self { planet })
+        Ok(Self {
+            planet,
+            prefetched: Arc::new(Mutex::new(HashMap::new())),
+        })
     }
 
     pub fn planet(&self) -> &Planet {
@@ -29,6 +52,26 @@ impl GeneratedTerrainSource {
     }
 
     pub async fn load_slab(&self, slab: SlabLocation) -> Result<Slab, TerrainSourceError> {
+        // take the terrain if it was already generated speculatively
+        let prefetched = {
+            let mut map = self.prefetched.lock();
+            match map.remove(&slab) {
+                Some(PrefetchedSlab::Ready(terrain)) => Some(terrain),
+                Some(PrefetchedSlab::InFlight) => {
+                    // the prefetch hasn't finished yet, race it with a fresh generation
+                    // and have it discard its result
+                    map.insert(slab, PrefetchedSlab::Taken);
+                    None
+                }
+                Some(PrefetchedSlab::Taken) | None => None,
+            }
+        };
+
+        if let Some(terrain) = prefetched {
+            debug!("using speculatively generated slab terrain"; slab);
+            return Ok(terrain);
+        }
+
         // TODO handle wrapping of slabs around planet boundaries
         let slab = self
             .planet
@@ -38,6 +81,34 @@ impl GeneratedTerrainSource {
         Ok(slab.into())
     }
 
+    /// Speculatively generates the given slab if it's not already cached or in flight, so
+    /// the real request for it becomes a lookup
+    pub async fn prefetch_slab(&self, slab: SlabLocation) {
+        // claim the slot first so concurrent prefetches don't duplicate work
+        match self.prefetched.lock().entry(slab) {
+            Entry::Occupied(_) => return,
+            Entry::Vacant(e) => {
+                e.insert(PrefetchedSlab::InFlight);
+            }
+        }
+
+        trace!("speculatively generating slab"; slab);
+        let terrain = self.planet.generate_slab(slab).await;
+
+        let mut map = self.prefetched.lock();
+        if let Some(PrefetchedSlab::InFlight) = map.get(&slab) {
+            if let Some(terrain) = terrain {
+                map.insert(slab, PrefetchedSlab::Ready(terrain.into()));
+                return;
+            }
+
+            // out of bounds, nothing worth keeping
+        }
+
+        // either overtaken by the real request or out of bounds
+        map.remove(&slab);
+    }
+
     pub async fn get_ground_level(&self, block: WorldPosition) -> Option<GlobalSliceIndex> {
         self.planet.find_ground_level(block).await
     }
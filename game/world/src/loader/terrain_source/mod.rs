@@ -73,6 +73,15 @@ impl TerrainSource {
         }
     }
 
+    /// Speculatively generate the slab so a later [load_slab] is just a lookup. Nop for
+    /// preloaded sources
+    pub async fn prefetch_slab(&self, slab: SlabLocation) {
+        match self {
+            TerrainSource::Memory(_) => {}
+            TerrainSource::Generated(src) => src.prefetch_slab(slab).await,
+        }
+    }
+
     /// z is ignored in input
     pub async fn get_ground_level(
         &self,
@@ -19,6 +19,17 @@ use tokio::task::JoinHandle;
 
 pub type LoadTerrainResult = Result<LoadedSlab, TerrainSourceError>;
 
+/// Cheaply cloneable handle for spawning standalone tasks on the worker pool without
+/// holding a reference to the loader
+#[derive(Clone)]
+pub struct WorkerHandle(tokio::runtime::Handle);
+
+impl WorkerHandle {
+    pub fn spawn(&self, task: impl Future<Output = ()> + Send + 'static) {
+        self.0.spawn(task);
+    }
+}
+
 pub struct AsyncWorkerPool {
     pool: tokio::runtime::Runtime,
     success_rx: async_channel::UnboundedReceiver<Result<SlabLocation, TerrainSourceError>>,
@@ -149,4 +160,8 @@ impl AsyncWorkerPool {
     pub fn runtime(&self) -> &Runtime {
         &self.pool
     }
+
+    pub fn handle(&self) -> WorkerHandle {
+        WorkerHandle(self.pool.handle().clone())
+    }
 }
@@ -2,11 +2,9 @@ use color::ColorRgb;
 use common::*;
 
 use crate::chunk::slab::Slab;
-use crate::chunk::slice::unflatten_index;
-use crate::chunk::Chunk;
+use crate::chunk::ChunkTerrainSnapshot;
 use crate::occlusion::{BlockOcclusion, OcclusionFlip};
 use crate::viewer::SliceRange;
-use crate::{BaseTerrain, WorldContext};
 use grid::GridImpl;
 use std::mem::MaybeUninit;
 use unit::world::CHUNK_SIZE;
@@ -22,53 +20,102 @@ pub trait BaseVertex: Copy + Debug {
     fn new(pos: (f32, f32, f32), color: ColorRgb) -> Self;
 }
 
-pub fn make_simple_render_mesh<V: BaseVertex, C: WorldContext>(
-    chunk: &Chunk<C>,
+/// Vertex produced by mesh workers, resolved into the renderer's own vertex type when
+/// the finished mesh is collected on the main thread
+#[derive(Copy, Clone, Debug)]
+pub struct UnresolvedVertex {
+    pos: (f32, f32, f32),
+    color: ColorRgb,
+}
+
+impl BaseVertex for UnresolvedVertex {
+    fn new(pos: (f32, f32, f32), color: ColorRgb) -> Self {
+        Self { pos, color }
+    }
+}
+
+impl UnresolvedVertex {
+    pub fn resolve<V: BaseVertex>(self) -> V {
+        V::new(self.pos, self.color)
+    }
+}
+
+/// Number of blocks in a single horizontal slice
+const SLICE_AREA: usize = CHUNK_SIZE.as_usize() * CHUNK_SIZE.as_usize();
+
+/// Per-slice mask of blocks eligible for greedy quad merging, holding each block's final colour.
+/// Blocks with any ambient occlusion are emitted individually instead, as their vertex colours
+/// vary per corner
+type QuadMask = [Option<ColorRgb>; SLICE_AREA];
+
+/// Operates on a terrain snapshot so it can run on a worker thread without holding the
+/// world lock. `base_slice` is rendered at z=0, allowing a sub-range (e.g. a single slab)
+/// to be meshed with the same vertical offset as the full view range it belongs to
+pub fn make_simple_render_mesh_with_base<V: BaseVertex>(
+    terrain: &ChunkTerrainSnapshot,
     slice_range: SliceRange,
+    base_slice: GlobalSliceIndex,
 ) -> Vec<V> {
     let mut vertices = Vec::<V>::new(); // TODO reuse/calculate needed capacity first
+    let mut mask: QuadMask = [None; SLICE_AREA];
 
     let shifted_slice_index = |slice_index: GlobalSliceIndex| {
-        // shift slice range down to 0..size, to keep render z position low and near 0
-        (slice_index - slice_range.bottom()).slice() as f32
+        // shift slice range down towards 0, to keep render z position low and near 0
+        (slice_index - base_slice).slice() as f32
     };
 
-    for (slice_index, slice) in chunk.slice_range(slice_range) {
+    let slices = slice_range
+        .as_range()
+        .map(|i| {
+            let index = GlobalSliceIndex::new(i);
+            terrain.slice(index).map(|s| (index, s))
+        })
+        .skip_while(|s| s.is_none())
+        .while_some();
+
+    for (slice_index, slice) in slices {
         // TODO skip if slice knows it is empty
 
-        let slice_above = chunk.slice_or_dummy(slice_index + 1);
+        let slice_above = terrain.slice_or_dummy(slice_index + 1);
         let slice_index = shifted_slice_index(slice_index);
 
+        debug_assert!(mask.iter().all(Option::is_none));
         for (i, block_pos, block) in slice.non_air_blocks() {
             // if above is solid, render a "blocked" colour
-            let tile = if slice_above
+            if slice_above
                 .index_unchecked(i)
                 .block_type()
                 .opacity()
                 .solid()
             {
-                let color = ColorRgb::new(50, 50, 50);
-                make_corners(block_pos, color, slice_index)
+                mask[i] = Some(ColorRgb::new(50, 50, 50));
             } else {
-                // render as normal
-                make_corners_with_ao(
-                    block_pos,
-                    block.block_type().color(),
-                    block.occlusion(),
-                    slice_index,
-                )
-            };
-
-            vertices.extend_from_slice(&tile);
+                let occlusion = block.occlusion();
+                if occlusion.is_fully_lit() {
+                    // flat colour, defer to the greedy pass
+                    mask[i] = Some(block.block_type().color());
+                } else {
+                    // per-vertex AO, must be a lone quad
+                    vertices.extend_from_slice(&make_corners_with_ao(
+                        block_pos,
+                        block.block_type().color(),
+                        occlusion,
+                        slice_index,
+                    ));
+                }
+            }
         }
+
+        merge_mask_into_quads(&mut mask, slice_index, &mut vertices);
     }
 
     // render 1 slice below in shadow to indicate where there are blocks out of view
     // TODO blocks filling in gaps should be tinted the colour of the block they're suggesting
     // TODO consider rendering a blurred buffer of slices below
-    if let Some(slice_bottom) = chunk.slice(slice_range.bottom()) {
-        let slice_below = chunk.slice_or_dummy(slice_range.bottom() - 1);
+    if let Some(slice_bottom) = terrain.slice(slice_range.bottom()) {
+        let slice_below = terrain.slice_or_dummy(slice_range.bottom() - 1);
 
+        debug_assert!(mask.iter().all(Option::is_none));
         slice_bottom
             .slice()
             .iter()
@@ -78,18 +125,66 @@ pub fn make_simple_render_mesh<V: BaseVertex, C: WorldContext>(
                 bottom.opacity().transparent() && below.opacity().solid()
             })
             .for_each(|(i, (_, _))| {
-                let color = ColorRgb::new(70, 70, 70);
-                vertices.extend_from_slice(&make_corners(
-                    unflatten_index(i),
-                    color,
-                    shifted_slice_index(slice_range.bottom()),
-                ));
+                mask[i] = Some(ColorRgb::new(70, 70, 70));
             });
+
+        merge_mask_into_quads(
+            &mut mask,
+            shifted_slice_index(slice_range.bottom()),
+            &mut vertices,
+        );
     }
 
     vertices
 }
 
+/// Greedily merges horizontal runs of same-coloured blocks into the widest/tallest possible
+/// quads, clearing the mask as it goes. Based on the same approach as [make_collision_mesh] but
+/// in 2d per slice
+fn merge_mask_into_quads<V: BaseVertex>(
+    mask: &mut QuadMask,
+    slice_index: f32,
+    vertices: &mut Vec<V>,
+) {
+    const DIM: usize = CHUNK_SIZE.as_usize();
+
+    for start in 0..SLICE_AREA {
+        let color = match mask[start] {
+            Some(color) => color,
+            None => continue,
+        };
+
+        let (x, y) = (start % DIM, start / DIM);
+
+        // extend quad rightwards while the colour matches
+        let mut w = 1;
+        while x + w < DIM && mask[start + w] == Some(color) {
+            w += 1;
+        }
+
+        // then extend upwards while whole rows match
+        let mut h = 1;
+        'rows: while y + h < DIM {
+            let row = start + (h * DIM);
+            for k in 0..w {
+                if mask[row + k] != Some(color) {
+                    break 'rows;
+                }
+            }
+            h += 1;
+        }
+
+        // consume the merged blocks
+        for dy in 0..h {
+            for dx in 0..w {
+                mask[start + (dy * DIM) + dx] = None;
+            }
+        }
+
+        vertices.extend_from_slice(&make_quad(x, y, w, h, color, slice_index));
+    }
+}
+
 fn block_centre(block: SliceBlock) -> (f32, f32) {
     let (x, y) = block.xy();
     (
@@ -136,24 +231,30 @@ fn make_corners_with_ao<V: BaseVertex>(
     // safety: all corners have been initialized
     unsafe { corners_to_vertices(block_corners) }
 }
-fn make_corners<V: BaseVertex>(block_pos: SliceBlock, color: ColorRgb, slice_index: f32) -> [V; 6] {
-    let (bx, by) = block_centre(block_pos);
-
-    let mut block_corners = [MaybeUninit::uninit(); TILE_CORNERS.len()];
-
-    for (i, (fx, fy)) in TILE_CORNERS.iter().enumerate() {
-        block_corners[i] = MaybeUninit::new(V::new(
-            (
-                fx + bx * unit::world::BLOCKS_SCALE,
-                fy + by * unit::world::BLOCKS_SCALE,
-                slice_index * unit::world::BLOCKS_SCALE,
-            ),
-            color,
-        ));
-    }
+/// `w * h` blocks from `(x, y)`, all the same colour
+fn make_quad<V: BaseVertex>(
+    x: usize,
+    y: usize,
+    w: usize,
+    h: usize,
+    color: ColorRgb,
+    slice_index: f32,
+) -> [V; 6] {
+    const SCALE: f32 = unit::world::BLOCKS_SCALE;
+    let (x0, y0) = (x as f32 * SCALE, y as f32 * SCALE);
+    let (x1, y1) = ((x + w) as f32 * SCALE, (y + h) as f32 * SCALE);
+    let z = slice_index * SCALE;
+
+    // same winding as TILE_CORNERS
+    let corners = [
+        MaybeUninit::new(V::new((x0, y0, z), color)),
+        MaybeUninit::new(V::new((x1, y0, z), color)),
+        MaybeUninit::new(V::new((x1, y1, z), color)),
+        MaybeUninit::new(V::new((x0, y1, z), color)),
+    ];
 
     // safety: all corners have been initialized
-    unsafe { corners_to_vertices(block_corners) }
+    unsafe { corners_to_vertices(corners) }
 }
 
 unsafe fn corners_to_vertices<V: BaseVertex>(block_corners: [MaybeUninit<V>; 4]) -> [V; 6] {
@@ -2,11 +2,14 @@ use std::collections::HashMap;
 use std::iter::once;
 
 use petgraph::stable_graph::StableGraph;
-use petgraph::Directed;
+use petgraph::visit::EdgeRef;
+use petgraph::{Directed, Direction};
 
 use common::*;
 use unit::world::CHUNK_SIZE;
-use unit::world::{BlockCoord, BlockPosition, ChunkLocation, GlobalSliceIndex, SliceBlock};
+use unit::world::{
+    BlockCoord, BlockPosition, ChunkLocation, GlobalSliceIndex, SlabIndex, SliceBlock,
+};
 
 use crate::navigation::astar::astar;
 use crate::navigation::path::AreaPathNode;
@@ -20,8 +23,7 @@ type NodeIndex = petgraph::prelude::NodeIndex<u32>;
 #[derive(Copy, Clone, PartialEq, Eq, Debug, Hash, Ord, PartialOrd)]
 pub(crate) struct AreaNavNode(pub WorldArea);
 
-#[derive(Copy, Clone)]
-#[cfg_attr(test, derive(Eq, PartialEq))]
+#[derive(Copy, Clone, Eq, PartialEq)]
 pub struct AreaNavEdge {
     pub direction: NeighbourOffset,
     pub cost: EdgeCost,
@@ -239,29 +241,108 @@ impl AreaGraph {
         }
     }
 
-    // pub(crate) fn remove_node(&mut self, area: &WorldArea) {
-    //     if let Some(node) = self.node_lookup.remove(area) {
-    //         // invalidate node, which removes all its edges too
-    //         let old = self.graph.remove_node(node);
-    //         debug_assert!(old.is_some(), "node was not in both lookup and graph")
-    //     }
-    // }
+    pub(crate) fn remove_node(&mut self, area: &WorldArea) {
+        if let Some(node) = self.node_lookup.remove(area) {
+            // invalidate node, which removes all its edges too
+            let old = self.graph.remove_node(node);
+            debug_assert!(old.is_some(), "node was not in both lookup and graph")
+        }
+    }
+
+    /// Incrementally updates the given slab range of a chunk after its areas were
+    /// rediscovered. Diffs `new_areas` against the nodes currently in the graph so only
+    /// areas that actually appeared or vanished are touched, and only relinks nodes whose
+    /// recomputed cross-chunk edges differ from what's already present - links between
+    /// unaffected neighbours are left alone
+    pub(crate) fn update_chunk_areas(
+        &mut self,
+        chunk: ChunkLocation,
+        slab_range: (SlabIndex, SlabIndex),
+        new_areas: impl Iterator<Item = WorldArea>,
+        new_edges: &[(WorldArea, WorldArea, AreaNavEdge)],
+    ) {
+        let in_range = |area: &WorldArea| {
+            area.chunk == chunk && area.slab >= slab_range.0 && area.slab <= slab_range.1
+        };
 
-    /// Removes all where f(area) == false.
-    /// Returns number removed
-    pub(crate) fn retain(&mut self, mut f: impl FnMut(&WorldArea) -> bool) -> usize {
-        let prev_n = (self.node_lookup.len(), self.graph.node_count());
-        debug_assert_eq!(prev_n.0, prev_n.1);
+        let new_areas: SmallVec<[WorldArea; 16]> = new_areas.collect();
+        let old_areas: SmallVec<[WorldArea; 16]> = self
+            .node_lookup
+            .keys()
+            .filter(|a| in_range(a))
+            .copied()
+            .collect();
 
-        self.node_lookup.retain(|n, _| f(n));
-        self.graph.retain_nodes(|graph, idx| {
-            let node = graph.node_weight(idx).unwrap();
-            f(&node.0)
-        });
+        debug_assert!(
+            new_edges.iter().all(|(src, _, _)| new_areas.contains(src)),
+            "recomputed edges should originate from the updated slab range"
+        );
 
-        let new_n = (self.node_lookup.len(), self.graph.node_count());
-        debug_assert_eq!(new_n.0, new_n.1);
-        prev_n.0 - new_n.0
+        // remove vanished areas, dropping their edges with them
+        let mut removed = 0usize;
+        for gone in old_areas.iter().filter(|a| !new_areas.contains(a)) {
+            self.remove_node(gone);
+            removed += 1;
+        }
+
+        // add newly discovered areas
+        let mut added = 0usize;
+        for fresh in new_areas.iter().filter(|a| !old_areas.contains(a)) {
+            self.add_node(*fresh);
+            added += 1;
+        }
+
+        // reconcile cross-chunk edges per node. only outgoing edges need comparing
+        // because every edge is added as a 2-way pair
+        let (mut relinked, mut untouched) = (0usize, 0usize);
+        let mut existing = Vec::new(); // TODO reuse buf
+        let mut stale = Vec::new(); // TODO reuse buf
+        for &area in new_areas.iter() {
+            let node = self.node_lookup[&area]; // added above if missing
+
+            let wanted: SmallVec<[(WorldArea, AreaNavEdge); 4]> = new_edges
+                .iter()
+                .filter(|(src, _, _)| *src == area)
+                .map(|(_, dst, edge)| (*dst, *edge))
+                .collect();
+
+            existing.clear();
+            existing.extend(
+                self.graph
+                    .edges(node)
+                    .map(|e| (self.graph[e.target()].0, *e.weight())),
+            );
+
+            if wanted.len() == existing.len() && wanted.iter().all(|e| existing.contains(e)) {
+                // this node's links survived the slab change untouched
+                untouched += 1;
+                continue;
+            }
+
+            // out with the old pairs...
+            stale.clear();
+            stale.extend(
+                self.graph
+                    .edges_directed(node, Direction::Outgoing)
+                    .chain(self.graph.edges_directed(node, Direction::Incoming))
+                    .map(|e| e.id()),
+            );
+            for edge in stale.drain(..) {
+                self.graph.remove_edge(edge);
+            }
+
+            // ...in with the new
+            for (dst, edge) in wanted.into_iter() {
+                self.add_edge(area, dst, edge);
+            }
+            relinked += 1;
+        }
+
+        debug!(
+            "patched area graph: {removed} removed, {added} added, {relinked} relinked, {untouched} untouched",
+            removed = removed, added = added, relinked = relinked, untouched = untouched;
+            "chunk" => ?chunk
+        );
     }
 
     fn get_node(&self, area: WorldArea) -> Result<NodeIndex, AreaPathError> {
@@ -310,14 +391,19 @@ impl Debug for AreaNavEdge {
 #[cfg(test)]
 mod tests {
     use unit::world::CHUNK_SIZE;
-    use unit::world::{BlockPosition, ChunkLocation, GlobalSliceIndex, SlabIndex, SLAB_SIZE};
+    use unit::world::{
+        BlockPosition, ChunkLocation, GlobalSliceIndex, SlabIndex, WorldPositionRange, SLAB_SIZE,
+    };
 
     use crate::block::BlockType;
     use crate::chunk::ChunkBuilder;
+    use crate::loader::WorldTerrainUpdate;
     use crate::navigation::path::AreaPathNode;
     use crate::navigation::{AreaGraph, AreaNavEdge, AreaPathError, SlabAreaIndex, WorldArea};
     use crate::neighbour::NeighbourOffset;
-    use crate::world::helpers::world_from_chunks_blocking;
+    use crate::world::helpers::{
+        apply_updates, loader_from_chunks_blocking, world_from_chunks_blocking,
+    };
     use crate::{ChunkDescriptor, EdgeCost};
     use std::convert::TryInto;
 
@@ -854,6 +940,55 @@ mod tests {
         assert_eq!(reversed.reversed(), edge);
     }
 
+    #[test]
+    fn single_block_dig_patches_graph_incrementally() {
+        // two flat chunks joined by a full width walk port
+        let chunks = vec![
+            ChunkBuilder::new()
+                .fill_slice(1, BlockType::Stone)
+                .build((0, 0)),
+            ChunkBuilder::new()
+                .fill_slice(1, BlockType::Stone)
+                .build((1, 0)),
+        ];
+
+        let mut loader = loader_from_chunks_blocking(chunks);
+        let world = loader.world();
+
+        let (nodes_before, edges_before, node_idx_before) = {
+            let w = world.borrow();
+            let graph = w.area_graph();
+            (
+                graph.node_count(),
+                graph.edge_count(),
+                graph.get_node(WorldArea::new((0, 0))).expect("node exists"),
+            )
+        };
+
+        // dig out a single block in the middle of chunk 0, far from the boundary. the
+        // area survives and the cross chunk port is unaffected
+        let updates = vec![WorldTerrainUpdate::new(
+            WorldPositionRange::with_single((4, 4, 1)),
+            BlockType::Air,
+        )];
+        apply_updates(&mut loader, &updates).expect("updates failed");
+
+        let w = world.borrow();
+        let graph = w.area_graph();
+        assert_eq!(graph.node_count(), nodes_before);
+        assert_eq!(graph.edge_count(), edges_before);
+
+        // surviving area kept its node instead of being dropped and readded
+        assert_eq!(
+            graph.get_node(WorldArea::new((0, 0))).expect("node exists"),
+            node_idx_before
+        );
+
+        // port is still intact
+        let _ = get_edge(graph, WorldArea::new((0, 0)), WorldArea::new((1, 0)))
+            .expect("edge should survive the dig");
+    }
+
     #[test]
     fn port_exit_closest() {
         assert_eq!(
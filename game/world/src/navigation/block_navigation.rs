@@ -48,6 +48,17 @@ impl BlockGraph {
         self.graph.add_edge(to, from, BlockNavEdge(cost.opposite()));
     }
 
+    /// Walkable neighbours of the given block within this graph, with the cost of
+    /// stepping to each
+    pub(crate) fn edges_from(
+        &self,
+        block: BlockPosition,
+    ) -> impl Iterator<Item = (BlockPosition, EdgeCost)> + '_ {
+        self.graph
+            .edges(BlockNavNode(block))
+            .map(|(_, to, e)| (to.0, e.0))
+    }
+
     #[cfg(test)]
     pub fn edges(&self, block: BlockPosition) -> Vec<(BlockPosition, EdgeCost)> {
         let node = BlockNavNode(block);
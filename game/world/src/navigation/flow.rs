@@ -0,0 +1,128 @@
+//! Flow fields for many-entities-to-one-goal movement
+
+use std::collections::HashMap;
+
+use common::*;
+use unit::world::WorldPosition;
+
+use crate::navigation::EdgeCost;
+
+/// Precomputed directions towards a single goal block, shared between many entities.
+/// Built once per goal with [crate::World::compute_flow_field] by integrating the block
+/// graph of each affected area, instead of every entity running its own block search
+pub struct FlowField {
+    goal: WorldPosition,
+
+    /// Next block towards the goal and the cost of stepping to it, for every covered block
+    directions: HashMap<WorldPosition, (WorldPosition, EdgeCost)>,
+}
+
+impl FlowField {
+    pub(crate) fn new(
+        goal: WorldPosition,
+        directions: HashMap<WorldPosition, (WorldPosition, EdgeCost)>,
+    ) -> Self {
+        Self { goal, directions }
+    }
+
+    pub fn goal(&self) -> WorldPosition {
+        self.goal
+    }
+
+    /// Next block to step to from the given block, or None if the block is not covered
+    /// by the field e.g. the follower strayed off the integrated areas
+    pub fn direction_from(&self, block: WorldPosition) -> Option<(WorldPosition, EdgeCost)> {
+        self.directions.get(&block).copied()
+    }
+
+    /// Number of covered blocks
+    pub fn len(&self) -> usize {
+        self.directions.len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.directions.is_empty()
+    }
+}
+
+impl Debug for FlowField {
+    fn fmt(&self, f: &mut Formatter<'_>) -> FmtResult {
+        write!(
+            f,
+            "FlowField(goal={}, blocks={})",
+            self.goal,
+            self.directions.len()
+        )
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use std::iter::once;
+
+    use unit::world::WorldPosition;
+
+    use crate::block::BlockType;
+    use crate::chunk::ChunkBuilder;
+    use crate::world::helpers::world_from_chunks_blocking;
+
+    #[test]
+    fn flow_field_within_area() {
+        let world = world_from_chunks_blocking(vec![ChunkBuilder::new()
+            .fill_slice(1, BlockType::Stone)
+            .build((0, 0))])
+        .into_inner();
+
+        let goal = WorldPosition::from((2, 2, 2));
+        let goal_area = world.area(goal).ok().expect("goal should have an area");
+
+        let field = world
+            .compute_flow_field(goal, once(goal_area))
+            .expect("flow field failed");
+
+        assert_eq!(field.goal(), goal);
+
+        // every walkable block except the goal itself gets a direction
+        assert!(field.direction_from(goal).is_none());
+        assert!(field.direction_from((10, 10, 2).into()).is_some());
+
+        // no direction off the field
+        assert!(field.direction_from((5, 5, 8).into()).is_none());
+    }
+
+    #[test]
+    fn flow_field_across_chunks() {
+        let world = world_from_chunks_blocking(vec![
+            ChunkBuilder::new()
+                .fill_slice(1, BlockType::Stone)
+                .build((0, 0)),
+            ChunkBuilder::new()
+                .fill_slice(1, BlockType::Stone)
+                .build((1, 0)),
+        ])
+        .into_inner();
+
+        let goal = WorldPosition::from((2, 2, 2));
+        let start = WorldPosition::from((20, 5, 2));
+        let start_area = world.area(start).ok().expect("start should have an area");
+
+        let field = world
+            .compute_flow_field(goal, once(start_area))
+            .expect("flow field failed");
+
+        // follow the field across the chunk boundary to the goal
+        let mut pos = start;
+        for _ in 0..256 {
+            if pos == field.goal() {
+                break;
+            }
+
+            let (next, _) = field
+                .direction_from(pos)
+                .unwrap_or_else(|| panic!("no direction from {}", pos));
+            pos = next;
+        }
+
+        assert_eq!(pos, field.goal());
+    }
+}
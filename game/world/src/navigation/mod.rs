@@ -2,6 +2,7 @@ pub use area_navigation::{AreaGraph, AreaNavEdge, AreaPathError};
 pub use block_navigation::{BlockGraph, BlockPathError};
 use common::*;
 pub use cost::EdgeCost;
+pub use flow::FlowField;
 pub use path::{
     AreaPath, BlockPath, BlockPathNode, NavigationError, SearchGoal, WorldPath, WorldPathNode,
 };
@@ -12,6 +13,7 @@ mod astar;
 mod block_navigation;
 mod cost;
 pub(crate) mod discovery;
+mod flow;
 mod path;
 
 /// Area index in a slab. 0 is uninitialized, starts at 1
@@ -20,8 +20,7 @@ pub trait NeighboursBehaviour {
 pub struct Slab;
 pub struct World;
 
-#[derive(Copy, Clone, Debug)]
-#[cfg_attr(test, derive(Eq, PartialEq))]
+#[derive(Copy, Clone, Debug, Eq, PartialEq)]
 #[repr(u8)]
 pub enum NeighbourOffset {
     South,
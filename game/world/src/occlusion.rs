@@ -1,11 +1,10 @@
-use common::derive_more::{Deref, DerefMut};
 use common::*;
 
 use crate::block::BlockOpacity;
-use crate::chunk::slice::Slice;
+use crate::chunk::slice::{flatten_coords, Slice};
 use crate::neighbour::NeighbourOffset;
 use std::ops::Add;
-use unit::world::SliceBlock;
+use unit::world::{SliceBlock, CHUNK_SIZE};
 
 #[derive(Copy, Clone, Debug, Eq, PartialEq, PartialOrd, Ord)]
 pub enum VertexOcclusion {
@@ -34,34 +33,51 @@ impl From<VertexOcclusion> for f32 {
     }
 }
 
-/// TODO bitset of Opacities will be much smaller, 2 bits each
-#[derive(Deref, DerefMut, Default, Copy, Clone)]
-pub struct NeighbourOpacity([OcclusionOpacity; NeighbourOffset::COUNT]);
+/// Packed 2-bit opacity per neighbour, low bit = known, high bit = solid. A block's whole
+/// neighbourhood fits in a u16, so copies and comparisons are single integer ops
+#[derive(Default, Copy, Clone, Eq, PartialEq)]
+pub struct NeighbourOpacity(u16);
+
+/// Low (known) bit of every 2-bit lane
+const KNOWN_LANES: u16 = 0x5555;
+
+/// High (solid) bit of every 2-bit lane
+const SOLID_LANES: u16 = 0xAAAA;
 
 impl NeighbourOpacity {
     pub const fn default_const() -> Self {
         // TODO this is different to the actual Default!
-        Self([OcclusionOpacity::Known(BlockOpacity::Transparent); NeighbourOffset::COUNT])
+        // all neighbours known transparent
+        Self(KNOWN_LANES)
     }
 
-    /// Reduce to `[0 = transparent/unknown, 1 = solid]`
-    fn opacities(&self) -> [u8; NeighbourOffset::COUNT] {
-        // TODO return a transmuted u16 when bitset is used, much cheaper to create and compare
-        [
-            self.0[0].as_u8(),
-            self.0[1].as_u8(),
-            self.0[2].as_u8(),
-            self.0[3].as_u8(),
-            self.0[4].as_u8(),
-            self.0[5].as_u8(),
-            self.0[6].as_u8(),
-            self.0[7].as_u8(),
-        ]
+    pub fn get(self, i: usize) -> OcclusionOpacity {
+        debug_assert!(i < NeighbourOffset::COUNT);
+        match (self.0 >> (i * 2)) & 0b11 {
+            0b01 => OcclusionOpacity::Known(BlockOpacity::Transparent),
+            0b11 => OcclusionOpacity::Known(BlockOpacity::Solid),
+            _ => OcclusionOpacity::Unknown,
+        }
+    }
+
+    pub fn set(&mut self, i: usize, opacity: OcclusionOpacity) {
+        debug_assert!(i < NeighbourOffset::COUNT);
+        let lane = match opacity {
+            OcclusionOpacity::Unknown => 0b00,
+            OcclusionOpacity::Known(BlockOpacity::Transparent) => 0b01,
+            OcclusionOpacity::Known(BlockOpacity::Solid) => 0b11,
+        };
+        self.0 = (self.0 & !(0b11 << (i * 2))) | (lane << (i * 2));
+    }
+
+    /// Reduce to a mask of `0 = transparent/unknown, 1 = solid` lanes
+    fn solid_lanes(self) -> u16 {
+        self.0 & SOLID_LANES
     }
 
     #[cfg(test)]
     pub fn all_solid() -> Self {
-        Self([OcclusionOpacity::Known(BlockOpacity::Solid); NeighbourOffset::COUNT])
+        Self(KNOWN_LANES | SOLID_LANES)
     }
 
     pub fn with_slice_above(this_block: SliceBlock, slice_above: Slice) -> NeighbourOpacity {
@@ -69,7 +85,28 @@ impl NeighbourOpacity {
         let mut opacity = NeighbourOpacity::default();
         for (n, offset) in NeighbourOffset::offsets() {
             if let Some(neighbour_block) = this_block.try_add(offset) {
-                opacity[n as usize] = slice_above[neighbour_block].opacity().into();
+                opacity.set(n as usize, slice_above[neighbour_block].opacity().into());
+            }
+        }
+
+        opacity
+    }
+
+    /// As [Self::with_slice_above] but samples a packed solidity bitmap instead of
+    /// striding across the full block array
+    pub fn with_cached_slice_above(
+        this_block: SliceBlock,
+        slice_above: &SliceSolidity,
+    ) -> NeighbourOpacity {
+        let mut opacity = NeighbourOpacity::default();
+        for (n, offset) in NeighbourOffset::offsets() {
+            if let Some(neighbour_block) = this_block.try_add(offset) {
+                let block_opacity = if slice_above.is_solid(neighbour_block) {
+                    BlockOpacity::Solid
+                } else {
+                    BlockOpacity::Transparent
+                };
+                opacity.set(n as usize, block_opacity.into());
             }
         }
 
@@ -79,12 +116,9 @@ impl NeighbourOpacity {
 
 impl Debug for NeighbourOpacity {
     fn fmt(&self, f: &mut Formatter<'_>) -> FmtResult {
-        let solids = self
-            .0
-            .iter()
-            .enumerate()
-            .filter(|(_, o)| o.solid())
-            .map(|(i, _)| {
+        let solids = (0..NeighbourOffset::COUNT)
+            .filter(|&i| self.get(i).solid())
+            .map(|i| {
                 // safety: limited to NeighbourOffset::COUNT
                 unsafe { std::mem::transmute::<_, NeighbourOffset>(i as u8) }
             });
@@ -92,6 +126,33 @@ impl Debug for NeighbourOpacity {
     }
 }
 
+const SLICE_WORDS: usize = (CHUNK_SIZE.as_usize() * CHUNK_SIZE.as_usize()) / 64;
+
+/// Packed per-slice solidity bitmap, one bit per block, so repeated neighbour sampling
+/// during occlusion init touches a few cache lines instead of the whole block array
+pub struct SliceSolidity([u64; SLICE_WORDS]);
+
+impl SliceSolidity {
+    pub fn new(slice: Slice) -> Self {
+        let mut words = [0u64; SLICE_WORDS];
+        for (i, block) in slice.slice().iter().enumerate() {
+            if block.opacity().solid() {
+                words[i / 64] |= 1 << (i % 64);
+            }
+        }
+        Self(words)
+    }
+
+    pub fn is_solid(&self, block: SliceBlock) -> bool {
+        self.is_solid_index(flatten_coords(block))
+    }
+
+    pub fn is_solid_index(&self, i: usize) -> bool {
+        debug_assert!(i < CHUNK_SIZE.as_usize() * CHUNK_SIZE.as_usize());
+        (self.0[i / 64] >> (i % 64)) & 1 == 1
+    }
+}
+
 #[derive(Debug, Copy, Clone)]
 pub enum OcclusionOpacity {
     /// Across a chunk boundary, treated as transparent
@@ -121,13 +182,6 @@ impl OcclusionOpacity {
             0
         }
     }
-
-    fn update(self, new: Self) -> Self {
-        match (self, new) {
-            (OcclusionOpacity::Unknown, known) | (known, OcclusionOpacity::Unknown) => known,
-            (_, new) => new,
-        }
-    }
 }
 
 /// "Is occluded"
@@ -167,13 +221,13 @@ impl BlockOcclusion {
 
     pub(crate) fn resolve_vertices(&self) -> ([VertexOcclusion; 4], OcclusionFlip) {
         let get_vertex = |corner_offset: NeighbourOffset| -> VertexOcclusion {
-            let s1 = self.0[corner_offset.next() as usize];
-            let s2 = self.0[corner_offset.prev() as usize];
+            let s1 = self.0.get(corner_offset.next() as usize);
+            let s2 = self.0.get(corner_offset.prev() as usize);
 
             let int_value = if s1.into() && s2.into() {
                 0
             } else {
-                let corner = self.0[corner_offset as usize];
+                let corner = self.0.get(corner_offset as usize);
                 3 - (s1.as_u8() + s2.as_u8() + corner.as_u8())
             };
 
@@ -200,12 +254,17 @@ impl BlockOcclusion {
         Self(NeighbourOpacity::default_const())
     }
 
+    /// No occluding neighbours at all, i.e. all vertices resolve to [VertexOcclusion::NotAtAll].
+    /// Such blocks are eligible for merging into bigger quads when meshing
+    pub(crate) fn is_fully_lit(&self) -> bool {
+        self.0.solid_lanes() == 0
+    }
+
     pub fn update_from_neighbour_opacities(&mut self, neighbours: NeighbourOpacity) {
-        (self.0)
-            .0
-            .iter_mut()
-            .zip(neighbours.0.iter())
-            .for_each(|(a, b)| *a = (*a).update(*b));
+        // known lanes take the new value, unknown lanes keep the old. multiplying the
+        // known bit by 0b11 expands it over its whole lane
+        let known = (neighbours.0 & KNOWN_LANES) * 0b11;
+        (self.0).0 = ((self.0).0 & !known) | (neighbours.0 & known);
     }
 
     #[cfg(test)]
@@ -223,9 +282,14 @@ impl Default for BlockOcclusion {
 
 impl PartialEq<NeighbourOpacity> for BlockOcclusion {
     fn eq(&self, other: &NeighbourOpacity) -> bool {
-        let my_opacities = self.0.opacities();
-        let ur_opacities = other.opacities();
-        my_opacities == ur_opacities
+        self.0.solid_lanes() == other.solid_lanes()
+    }
+}
+
+/// Only compares the visible result, i.e. which neighbours are solid
+impl PartialEq for BlockOcclusion {
+    fn eq(&self, other: &Self) -> bool {
+        self.0.solid_lanes() == other.0.solid_lanes()
     }
 }
 
@@ -259,12 +323,12 @@ mod tests {
     fn after_block_removed() {
         let neighbour_occluded = {
             let mut o = NeighbourOpacity::default();
-            o.0[0] = OcclusionOpacity::Known(BlockOpacity::Solid);
+            o.set(0, OcclusionOpacity::Known(BlockOpacity::Solid));
             o
         };
         let neighbour_not_occluded = {
             let mut o = NeighbourOpacity::default();
-            o.0[0] = OcclusionOpacity::Known(BlockOpacity::Transparent);
+            o.set(0, OcclusionOpacity::Known(BlockOpacity::Transparent));
             o
         };
 
@@ -1,20 +1,33 @@
 use common::*;
 
-use crate::mesh::BaseVertex;
+use crate::loader::WorkerHandle;
+use crate::mesh::{BaseVertex, UnresolvedVertex};
 use crate::{mesh, InnerWorldRef, WorldContext, WorldRef};
+use futures::channel::mpsc as async_channel;
 use std::collections::HashSet;
 use std::ops::{Add, RangeInclusive};
 use unit::world::{
     all_slabs_in_range, ChunkLocation, GlobalSliceIndex, SlabLocation, WorldPosition,
 };
 
-#[derive(Clone)]
+/// Max finished slab meshes handed to the renderer per frame, so a storm of dirty slabs
+/// (e.g. an explosion) amortizes its uploads over several frames instead of hitching one
+const MESH_UPLOADS_PER_FRAME: usize = 8;
+
+type FinishedMesh = (SlabLocation, Vec<UnresolvedVertex>);
+
 pub struct WorldViewer<C: WorldContext> {
     world: WorldRef<C>,
     view_range: SliceRange,
     chunk_range: (ChunkLocation, ChunkLocation),
     clean_slabs: HashSet<SlabLocation>,
     requested_slabs: Vec<SlabLocation>,
+    mesh_workers: WorkerHandle,
+    /// Slab meshes generated on worker threads, drained by the frame loop
+    finished_meshes_rx: async_channel::UnboundedReceiver<FinishedMesh>,
+    finished_meshes_tx: async_channel::UnboundedSender<FinishedMesh>,
+    /// Slabs with a mesh task currently on a worker, not respawned until it completes
+    in_flight_meshes: HashSet<SlabLocation>,
 }
 
 #[derive(Debug, Clone, Error)]
@@ -111,6 +124,7 @@ impl<C: WorldContext> WorldViewer<C> {
     pub fn with_world(
         world: WorldRef<C>,
         initial_block: WorldPosition,
+        mesh_workers: WorkerHandle,
     ) -> Result<Self, WorldViewerError> {
         let world_bounds = {
             let w = world.borrow();
@@ -131,37 +145,88 @@ impl<C: WorldContext> WorldViewer<C> {
         info!("positioning world viewer at {:?}", view_range);
 
         let initial_chunk = ChunkLocation::from(initial_block);
+        let (finished_meshes_tx, finished_meshes_rx) = async_channel::unbounded();
         Ok(Self {
             world,
             view_range,
             chunk_range: (initial_chunk, initial_chunk), // TODO is this ok?
             clean_slabs: HashSet::with_capacity(128),
             requested_slabs: Vec::with_capacity(128),
+            mesh_workers,
+            finished_meshes_rx,
+            finished_meshes_tx,
+            in_flight_meshes: HashSet::with_capacity(64),
         })
     }
 
-    pub fn regenerate_dirty_chunk_meshes<F: FnMut(ChunkLocation, Vec<V>), V: BaseVertex>(
+    /// Meshes are regenerated per dirty slab on the loader's worker pool from cheap
+    /// copy-on-write terrain snapshots, so the frame loop never meshes while holding the
+    /// world lock. Finished meshes are handed to `f` within a per-frame budget
+    pub fn regenerate_dirty_chunk_meshes<F: FnMut(SlabLocation, Vec<V>), V: BaseVertex>(
         &mut self,
         mut f: F,
     ) {
+        // collect meshes completed by the workers since last frame
+        for _ in 0..MESH_UPLOADS_PER_FRAME {
+            let (slab, mesh) = match self.finished_meshes_rx.try_next() {
+                Ok(Some(finished)) => finished,
+                _ => break, // empty, or all senders somehow dropped
+            };
+
+            self.in_flight_meshes.remove(&slab);
+            f(slab, mesh.into_iter().map(UnresolvedVertex::resolve).collect());
+        }
+
         let range = self.terrain_range();
         let world = self.world.borrow();
 
-        for dirty_chunk in self
-            .visible_slabs(range)
-            .filter_map(|slab| self.is_slab_dirty(&slab).as_some(slab.chunk))
-            .dedup()
-            .filter_map(|chunk| world.find_chunk_with_pos(chunk))
-        {
-            // TODO do mesh generation on a worker thread? or just do this bit in a parallel iter
-            let mesh = mesh::make_simple_render_mesh(dirty_chunk, range);
-            trace!("chunk mesh has {count} vertices", count = mesh.len(); dirty_chunk.pos());
-            f(dirty_chunk.pos(), mesh);
+        for dirty_slab in self.visible_slabs(range) {
+            if !self.is_slab_dirty(&dirty_slab) {
+                continue;
+            }
+
+            if self.in_flight_meshes.contains(&dirty_slab) {
+                // already being meshed, stays dirty so it is respawned with the latest
+                // terrain once the stale result comes back
+                continue;
+            }
+
+            let chunk = match world.find_chunk_with_pos(dirty_slab.chunk) {
+                Some(chunk) => chunk,
+                None => {
+                    self.clean_slabs.insert(dirty_slab);
+                    continue;
+                }
+            };
+
+            // clip the slab to the visible range. slab slice range is exclusive at the top
+            let (slab_bottom, slab_top) = dirty_slab.slab.slice_range();
+            let sub_range = match SliceRange::from_bounds(
+                slab_bottom.max(range.bottom()),
+                (slab_top - 1).min(range.top()),
+            ) {
+                Some(range) => range,
+                None => {
+                    self.clean_slabs.insert(dirty_slab);
+                    continue;
+                }
+            };
+
+            // z offsets stay relative to the full view range bottom, so slab meshes stack
+            let base_slice = range.bottom();
+            let terrain = chunk.terrain_snapshot();
+            let finished_tx = self.finished_meshes_tx.clone();
+            self.mesh_workers.spawn(async move {
+                let mesh = mesh::make_simple_render_mesh_with_base(&terrain, sub_range, base_slice);
+                trace!("slab mesh has {count} vertices", count = mesh.len(); dirty_slab);
+
+                // error means the viewer has gone away, drop the mesh
+                let _ = finished_tx.unbounded_send((dirty_slab, mesh));
+            });
+
+            self.in_flight_meshes.insert(dirty_slab);
+            self.clean_slabs.insert(dirty_slab);
         }
-
-        drop(world);
-
-        self.clean_slabs.extend(self.visible_slabs(range));
     }
 
     fn invalidate_meshes(&mut self) {
@@ -271,6 +336,19 @@ impl<C: WorldContext> WorldViewer<C> {
         self.chunk_range
     }
 
+    /// Slab nearest the centre of the current view, used to prioritize slab loading.
+    /// Tracks camera movement from [Self::move_by] and [Self::set_chunk_bounds]
+    pub fn centre_slab(&self) -> SlabLocation {
+        let (min, max) = self.chunk_range;
+        let chunk = ChunkLocation((min.0 + max.0) / 2, (min.1 + max.1) / 2);
+
+        let centre_slice = GlobalSliceIndex::new(
+            (self.view_range.bottom().slice() + self.view_range.top().slice()) / 2,
+        );
+
+        SlabLocation::new(centre_slice.slab_index(), chunk)
+    }
+
     fn is_slab_dirty(&self, slab: &SlabLocation) -> bool {
         !self.clean_slabs.contains(slab)
     }
@@ -1,4 +1,5 @@
-use std::collections::HashSet;
+use std::cmp::Reverse;
+use std::collections::{BinaryHeap, HashMap, HashSet};
 use std::iter::once;
 
 use common::derive_more::Constructor;
@@ -14,10 +15,11 @@ use crate::block::{Block, BlockDurability, BlockType};
 use crate::chunk::{BaseTerrain, BlockDamageResult, Chunk};
 use crate::loader::{LoadedSlab, SlabTerrainUpdate};
 use crate::navigation::{
-    AreaGraph, AreaNavEdge, AreaPath, BlockPath, NavigationError, SearchGoal, WorldArea, WorldPath,
-    WorldPathNode,
+    AreaGraph, AreaNavEdge, AreaPath, BlockPath, EdgeCost, FlowField, NavigationError, SearchGoal,
+    WorldArea, WorldPath, WorldPathNode,
 };
 use crate::neighbour::WorldNeighbours;
+use crate::occlusion::{BlockOcclusion, NeighbourOpacity};
 use crate::{OcclusionChunkUpdate, SliceRange};
 
 use std::sync::atomic::{AtomicUsize, Ordering};
@@ -25,7 +27,8 @@ use std::sync::Arc;
 use tokio::sync::broadcast;
 
 pub trait WorldContext: 'static + Send + Sync {
-    type AssociatedBlockData;
+    /// Sync so the world can be shared with worker threads, e.g. batched occlusion resolution
+    type AssociatedBlockData: Sync;
 }
 
 /// All mutable world changes must go through `loader.apply_terrain_updates`
@@ -195,6 +198,27 @@ impl<C: WorldContext> World<C> {
         to: WorldPosition,
         goal: SearchGoal,
     ) -> Result<WorldPath, NavigationError> {
+        let (from, to, goal) = self.resolve_path_endpoints(from, to, goal)?;
+
+        // same blocks
+        if from == to {
+            return Ok(WorldPath::new(Vec::new(), to));
+        }
+
+        // find area path
+        let area_path = self.find_area_path(from, to)?;
+
+        self.expand_area_path(from, to, goal, &area_path)
+    }
+
+    /// Resolves both endpoints of a path to accessible blocks, adjusting the target and
+    /// goal for [SearchGoal::Adjacent]
+    pub(crate) fn resolve_path_endpoints(
+        &self,
+        from: WorldPosition,
+        to: WorldPosition,
+        goal: SearchGoal,
+    ) -> Result<(WorldPosition, WorldPosition, SearchGoal), NavigationError> {
         let from = self
             .find_accessible_block_in_column_with_range(from, None)
             .ok_or(NavigationError::SourceNotWalkable(from))?;
@@ -226,14 +250,27 @@ impl<C: WorldContext> World<C> {
         }
         .ok_or(NavigationError::TargetNotWalkable(to))?;
 
-        // same blocks
-        if from == to {
-            return Ok(WorldPath::new(Vec::new(), to));
-        }
+        Ok((from, to, goal))
+    }
 
-        // find area path
-        let area_path = self.find_area_path(from, to)?;
+    /// Area-level path between 2 known areas
+    pub(crate) fn find_area_path_between(
+        &self,
+        from: WorldArea,
+        to: WorldArea,
+    ) -> Result<AreaPath, NavigationError> {
+        Ok(self.area_graph.find_area_path(from, to)?)
+    }
 
+    /// Expands an area-level path into a full block-level path. `area_path` must start in
+    /// `from`'s area and end in `to`'s
+    pub(crate) fn expand_area_path(
+        &self,
+        from: WorldPosition,
+        to: WorldPosition,
+        goal: SearchGoal,
+        area_path: &AreaPath,
+    ) -> Result<WorldPath, NavigationError> {
         // TODO optimize path with raytracing (#50)
         // TODO only calculate path for each area as needed (#51)
 
@@ -293,6 +330,130 @@ impl<C: WorldContext> World<C> {
         self.area_graph.path_exists(from, to)
     }
 
+    /// Computes a flow field towards the given goal block, shared between any number of
+    /// followers. Integrates the block graph of the goal's area and of every area along
+    /// the area paths from `from_areas` exactly once, so the cost scales with the number
+    /// of affected areas rather than the number of followers
+    pub fn compute_flow_field(
+        &self,
+        goal: WorldPosition,
+        from_areas: impl Iterator<Item = WorldArea>,
+    ) -> Result<FlowField, NavigationError> {
+        let goal = self
+            .find_accessible_block_in_column_with_range(goal, None)
+            .ok_or(NavigationError::TargetNotWalkable(goal))?;
+
+        let goal_area = self
+            .area(goal)
+            .ok()
+            .ok_or(NavigationError::TargetNotWalkable(goal))?;
+
+        // collect areas to integrate, and the boundary crossings linking them, from
+        // area level paths towards the goal. keyed by the block entered in the area
+        // nearer the goal, valued by the exit block left behind and the crossing cost
+        let mut areas = HashSet::with_capacity(16);
+        let mut crossings: HashMap<WorldPosition, Vec<(WorldPosition, WorldArea, EdgeCost)>> =
+            HashMap::new();
+
+        areas.insert(goal_area);
+
+        for from_area in from_areas {
+            if areas.contains(&from_area) {
+                // already integrated by an earlier path
+                continue;
+            }
+
+            let area_path = match self.find_area_path_between(from_area, goal_area) {
+                Ok(path) => path,
+                Err(err) => {
+                    // unreachable areas are just left out of the field
+                    debug!("flow field skipping unreachable area"; "area" => ?from_area, "error" => %err);
+                    continue;
+                }
+            };
+
+            for (a, b) in area_path.0.iter().tuple_windows() {
+                areas.insert(a.area);
+                areas.insert(b.area);
+
+                // unwrap ok because all except the first are Some
+                let entry: AreaNavEdge = b.entry.unwrap();
+
+                // link every block along the port's width, so followers can cross
+                // wherever is closest instead of funnelling through a single block
+                let first = SliceBlock::from(entry.exit);
+                let flip = entry.direction.is_vertical();
+                for i in 0..entry.width as i16 {
+                    let offset = if flip { (i, 0) } else { (0, i) };
+                    let exit = match first.try_add(offset) {
+                        Some(block) => block.to_block_position(entry.exit.z()),
+                        None => continue,
+                    };
+
+                    let entered = entry
+                        .direction
+                        .extend_across_boundary(exit)
+                        .above_by(entry.cost.z_offset());
+
+                    crossings
+                        .entry(entered.to_world_position(b.area.chunk))
+                        .or_default()
+                        .push((exit.to_world_position(a.area.chunk), a.area, entry.cost));
+                }
+            }
+        }
+
+        // dijkstra outwards from the goal, walking every edge in reverse so each stored
+        // direction points back towards the goal
+        let mut directions = HashMap::with_capacity(areas.len() * CHUNK_SIZE.as_usize());
+        let mut best: HashMap<WorldPosition, f32> = HashMap::with_capacity(directions.capacity());
+        let mut frontier = BinaryHeap::new();
+
+        best.insert(goal, 0.0);
+        frontier.push(Reverse((OrderedFloat(0.0), goal, goal_area)));
+
+        while let Some(Reverse((OrderedFloat(cost), block, area))) = frontier.pop() {
+            if best.get(&block).map(|&b| cost > b).unwrap_or(false) {
+                // stale queue entry, already expanded more cheaply
+                continue;
+            }
+
+            // step backwards within this area's block graph
+            if let Some(graph) = self
+                .find_chunk_with_pos(area.chunk)
+                .and_then(|c| c.block_graph_for_area(area))
+            {
+                for (neighbour, edge_cost) in graph.edges_from(block.into()) {
+                    // cost and direction of walking the edge back towards the goal
+                    let towards_goal = edge_cost.opposite();
+                    let neighbour = neighbour.to_world_position(area.chunk);
+                    let new_cost = cost + towards_goal.weight();
+
+                    if best.get(&neighbour).map(|&b| new_cost < b).unwrap_or(true) {
+                        best.insert(neighbour, new_cost);
+                        directions.insert(neighbour, (block, towards_goal));
+                        frontier.push(Reverse((OrderedFloat(new_cost), neighbour, area)));
+                    }
+                }
+            }
+
+            // step backwards across any area boundaries entered at this block
+            if let Some(links) = crossings.get(&block) {
+                for &(exit, exit_area, crossing_cost) in links {
+                    let new_cost = cost + crossing_cost.weight();
+
+                    if best.get(&exit).map(|&b| new_cost < b).unwrap_or(true) {
+                        best.insert(exit, new_cost);
+                        directions.insert(exit, (block, crossing_cost));
+                        frontier.push(Reverse((OrderedFloat(new_cost), exit, exit_area)));
+                    }
+                }
+            }
+        }
+
+        Ok(FlowField::new(goal, directions))
+    }
+
     pub fn find_accessible_block_in_column(&self, x: i32, y: i32) -> Option<WorldPosition> {
         self.find_accessible_block_in_column_with_range(
             WorldPosition(x, y, SliceIndex::top()),
@@ -346,7 +507,6 @@ impl<C: WorldContext> World<C> {
         area_nav: &[(WorldArea, WorldArea, AreaNavEdge)],
         slab_range: (SlabIndex, SlabIndex),
     ) {
-        // add all areas even if they currently have no edges
         {
             // safety: area graph is totally separate from chunk lookup
             let naughty_area_graph: &mut AreaGraph =
@@ -354,28 +514,15 @@ impl<C: WorldContext> World<C> {
 
             let chunk = self.find_chunk_with_pos(chunk_loc).expect("no such chunk");
 
-            // remove all previous areas and edges for the slab range in this chunk
-            let removed = naughty_area_graph.retain(|area| {
-                !(area.chunk == chunk_loc
-                    && (area.slab >= slab_range.0 && area.slab <= slab_range.1))
-            });
-
-            for area in chunk.areas() {
-                trace!("has area {:?}", area);
-                naughty_area_graph.add_node(area.into_world_area(chunk_loc));
-            }
-
-            let added = chunk.area_count();
-            debug!(
-                "removed {removed} areas and added {added}",
-                removed = removed,
-                added = added
-            );
-        }
+            // diff the rediscovered area set against the graph and patch only what
+            // changed, instead of dropping and rebuilding the whole slab range. a single
+            // dug out block usually leaves all nodes and edges untouched
+            let new_areas = chunk
+                .areas()
+                .filter(|area| area.slab >= slab_range.0 && area.slab <= slab_range.1)
+                .map(|area| area.into_world_area(chunk_loc));
 
-        // update area nodes and edges
-        for &(src, dst, edge) in area_nav {
-            self.area_graph.add_edge(src, dst, edge);
+            naughty_area_graph.update_chunk_areas(chunk_loc, slab_range, new_areas, area_nav);
         }
 
         // mark slabs dirty
@@ -384,6 +531,88 @@ impl<C: WorldContext> World<C> {
             .extend(slabs.map(|s| SlabLocation::new(s, chunk_loc)));
     }
 
+    /// Applies a tick's worth of occlusion updates in one pass. Updates are grouped by
+    /// chunk and each chunk's final per-block occlusion is resolved in parallel against
+    /// the immutable world, leaving only the writes for the single mutable pass
+    pub fn apply_occlusion_updates_batch(&mut self, updates: Vec<OcclusionChunkUpdate>) {
+        use rayon::prelude::*;
+
+        if updates.is_empty() {
+            return;
+        }
+
+        // group updates by chunk, preserving order within each chunk
+        let mut by_chunk: HashMap<ChunkLocation, Vec<(BlockPosition, NeighbourOpacity)>> =
+            HashMap::with_capacity(updates.len());
+        for OcclusionChunkUpdate(chunk_pos, updates) in updates {
+            by_chunk.entry(chunk_pos).or_default().extend(updates);
+        }
+
+        // resolve each chunk's merged occlusion values in parallel, keeping only blocks
+        // whose visible occlusion actually changes to avoid pointless CoW slab copies
+        let resolved: Vec<(ChunkLocation, Vec<(BlockPosition, BlockOcclusion)>)> = by_chunk
+            .into_par_iter()
+            .filter_map(|(chunk_pos, updates)| {
+                let chunk = self.find_chunk_with_pos(chunk_pos)?;
+                let terrain = chunk.raw_terrain();
+
+                let mut merged: HashMap<BlockPosition, BlockOcclusion> =
+                    HashMap::with_capacity(updates.len());
+                for (block_pos, opacities) in updates {
+                    let occlusion = merged.entry(block_pos).or_insert_with(|| {
+                        *terrain.slice_unchecked(block_pos.z())[block_pos].occlusion()
+                    });
+                    occlusion.update_from_neighbour_opacities(opacities);
+                }
+
+                let changed = merged
+                    .into_iter()
+                    .filter(|&(block_pos, occlusion)| {
+                        *terrain.slice_unchecked(block_pos.z())[block_pos].occlusion()
+                            != occlusion
+                    })
+                    .collect_vec();
+
+                (!changed.is_empty()).as_some((chunk_pos, changed))
+            })
+            .collect();
+
+        // apply resolved values in a single mutable pass
+        for (chunk_pos, changed) in resolved {
+            let applied = changed.len();
+            let mut dirty_slabs = SmallVec::<[SlabIndex; 8]>::new();
+
+            let chunk = match self.find_chunk_with_pos_mut(chunk_pos) {
+                Some(chunk) => chunk,
+                None => continue,
+            };
+
+            let terrain = chunk.raw_terrain_mut();
+            for (block_pos, occlusion) in changed {
+                let block = &mut terrain.slice_mut_unchecked_with_cow(block_pos.z())[block_pos];
+                *block.occlusion_mut() = occlusion;
+
+                let slab = block_pos.z().slab_index();
+                if dirty_slabs.last() != Some(&slab) {
+                    dirty_slabs.push(slab);
+                }
+            }
+
+            debug!(
+                "applied {applied} batched occlusion updates across {slabs} slabs",
+                applied = applied,
+                slabs = dirty_slabs.len();
+                chunk_pos
+            );
+
+            self.dirty_slabs.extend(
+                dirty_slabs
+                    .into_iter()
+                    .map(|slab| SlabLocation::new(slab, chunk_pos)),
+            );
+        }
+    }
+
     pub fn apply_occlusion_update(&mut self, update: OcclusionChunkUpdate) {
         let OcclusionChunkUpdate(chunk_pos, updates) = update;
         let len_before = self.dirty_slabs.len();
@@ -1089,6 +1318,10 @@ pub mod helpers {
         loader_from_chunks_blocking(chunks).world()
     }
 
+    pub fn world_from_source(source: MemoryTerrainSource) -> WorldRef<DummyWorldContext> {
+        load_world(source, AsyncWorkerPool::new_blocking().unwrap()).world()
+    }
+
     pub fn loader_from_chunks_blocking(
         chunks: Vec<ChunkDescriptor>,
     ) -> WorldLoader<DummyWorldContext> {
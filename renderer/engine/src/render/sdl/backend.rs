@@ -270,11 +270,11 @@ impl InitializedSimulationBackend for SdlBackendInit {
 
         let renderer = self.backend.renderer.terrain_mut();
         self.world_viewer
-            .regenerate_dirty_chunk_meshes(|chunk_pos, mesh| {
-                if let Err(e) = renderer.update_chunk_mesh(chunk_pos, mesh) {
+            .regenerate_dirty_chunk_meshes(|slab, mesh| {
+                if let Err(e) = renderer.update_slab_mesh(slab, mesh) {
                     error!(
-                        "failed to regenerate mesh for chunk";
-                        chunk_pos, "error" => %e
+                        "failed to regenerate mesh for slab";
+                        slab, "error" => %e
                     );
                 }
             });
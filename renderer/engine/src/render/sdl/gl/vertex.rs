@@ -271,6 +271,19 @@ impl<'a> ScopedBind<'a, Vbo> {
         }
     }
 
+    /// Issues a single multi-draw over the given (first, count) vertex ranges
+    pub fn multi_draw_arrays(&self, primitive: Primitive, firsts: &[i32], counts: &[i32]) {
+        debug_assert_eq!(firsts.len(), counts.len());
+        unsafe {
+            gl::MultiDrawArrays(
+                primitive.into(),
+                firsts.as_ptr(),
+                counts.as_ptr(),
+                firsts.len() as GLsizei,
+            );
+        }
+    }
+
     /*
     pub fn draw_array_instanced(
         &self,
@@ -4,11 +4,11 @@ use color::ColorRgb;
 use common::*;
 use simulation::{BaseVertex, WorldViewer};
 use unit::space::view::ViewPoint;
-use unit::world::{ChunkLocation, WorldPoint};
+use unit::world::{ChunkLocation, SlabIndex, SlabLocation, WorldPoint};
 
 use crate::render::sdl::gl::{
-    AttribType, BufferUsage, Capability, GlResult, Normalized, Primitive, Program, ScopedBindable,
-    Vao, Vbo,
+    AttribType, BufferUsage, Capability, GlResult, Normalized, Primitive, Program, ScopedBind,
+    ScopedBindable, Vao, Vbo,
 };
 use cgmath::Matrix;
 use resources::Shaders;
@@ -28,10 +28,27 @@ impl BaseVertex for WorldVertex {
     }
 }
 
+/// Vertex capacity granularity of a slab's sub-range, so edits that change the vertex
+/// count a little reuse the reserved range instead of relayouting the whole buffer
+const SLAB_CAPACITY_QUANTUM: usize = 1024;
+
+/// One slab's vertex sub-range within its chunk's shared vbo
+struct SlabRange {
+    slab: SlabIndex,
+    /// Offset into the vbo in vertices
+    offset: usize,
+    /// Reserved vertices, valid count is `vertices.len()`
+    capacity: usize,
+    /// Kept on the cpu side to re-upload when the buffer is relayouted
+    vertices: Vec<WorldVertex>,
+}
+
 pub struct ChunkMesh {
     vao: Vao,
     vbo: Vbo,
     chunk_pos: ChunkLocation,
+    /// Sorted by slab, offsets ascend in the same order
+    ranges: Vec<SlabRange>,
 }
 
 pub struct TerrainRenderer {
@@ -49,38 +66,24 @@ impl TerrainRenderer {
         })
     }
 
-    pub fn update_chunk_mesh(
+    /// Uploads a single slab's new vertices, touching only its sub-range of the chunk
+    /// vbo unless the slab outgrew its reserved capacity
+    pub fn update_slab_mesh(
         &mut self,
-        chunk_pos: ChunkLocation,
+        slab: SlabLocation,
         new_mesh: Vec<WorldVertex>,
     ) -> GlResult<()> {
         let mesh = self
             .chunk_meshes
-            .entry(chunk_pos)
+            .entry(slab.chunk)
             .or_insert_with(|| ChunkMesh {
                 vao: Vao::new(),
                 vbo: Vbo::array_buffer(),
-                chunk_pos,
+                chunk_pos: slab.chunk,
+                ranges: Vec::with_capacity(8),
             });
 
-        // bind vao and vbo
-        let bound_vao = mesh.vao.scoped_bind();
-        let bound_vbo = mesh.vbo.scoped_bind();
-
-        // setup vao attribs
-        if !new_mesh.is_empty() {
-            bound_vao
-                .vertex_attribs()
-                .add(3, AttribType::Float32, Normalized::FixedPoint) // pos
-                .add(4, AttribType::UByte, Normalized::Normalized) // col
-                .build()?;
-        }
-
-        // allocate mesh data
-        bound_vbo.buffer_data(&new_mesh, BufferUsage::DynamicDraw)?;
-        debug!("regenerated mesh"; chunk_pos);
-
-        Ok(())
+        mesh.update_slab(slab.slab, new_mesh)
     }
 
     pub fn render(&self, proj: &Matrix4, view: &Matrix4, world_viewer: &WorldViewer) {
@@ -91,9 +94,24 @@ impl TerrainRenderer {
         // enable face culling
         let _cull = Capability::CullFace.scoped_enable();
 
+        // collected per chunk, one multi-draw each
+        let mut firsts = SmallVec::<[i32; 16]>::new();
+        let mut counts = SmallVec::<[i32; 16]>::new();
+
         let mut count = 0;
         for chunk_pos in world_viewer.visible_chunks() {
             if let Some(mesh) = self.chunk_meshes.get(&chunk_pos) {
+                firsts.clear();
+                counts.clear();
+                for range in mesh.ranges.iter().filter(|r| !r.vertices.is_empty()) {
+                    firsts.push(range.offset as i32);
+                    counts.push(range.vertices.len() as i32);
+                }
+
+                if firsts.is_empty() {
+                    continue;
+                }
+
                 let _vao = mesh.vao.scoped_bind();
                 let vbo = mesh.vbo.scoped_bind();
 
@@ -108,7 +126,7 @@ impl TerrainRenderer {
 
                 prog.set_uniform_matrix("view\0", view.as_ptr());
 
-                vbo.draw_array(Primitive::Triangles);
+                vbo.multi_draw_arrays(Primitive::Triangles, &firsts, &counts);
                 count += 1;
             }
         }
@@ -120,3 +138,87 @@ impl TerrainRenderer {
         self.chunk_meshes.clear();
     }
 }
+
+impl ChunkMesh {
+    fn update_slab(&mut self, slab: SlabIndex, vertices: Vec<WorldVertex>) -> GlResult<()> {
+        let bound_vao = self.vao.scoped_bind();
+        let bound_vbo = self.vbo.scoped_bind();
+
+        match self.ranges.binary_search_by_key(&slab, |r| r.slab) {
+            Ok(i) if vertices.len() <= self.ranges[i].capacity => {
+                // fits in the slab's reserved range, upload just that
+                let range = &mut self.ranges[i];
+                range.vertices = vertices;
+                bound_vbo.buffer_sub_data(range.offset, &range.vertices)?;
+                trace!(
+                    "updated slab sub-range in place";
+                    self.chunk_pos, slab, "vertices" => range.vertices.len()
+                );
+            }
+            idx => {
+                // new slab or outgrown capacity, relayout the whole buffer
+                match idx {
+                    Ok(i) => self.ranges[i].vertices = vertices,
+                    Err(i) => self.ranges.insert(
+                        i,
+                        SlabRange {
+                            slab,
+                            offset: 0,
+                            capacity: 0,
+                            vertices,
+                        },
+                    ),
+                }
+
+                self.relayout(&bound_vao, &bound_vbo)?;
+            }
+        }
+
+        Ok(())
+    }
+
+    /// Reassigns every slab's sub-range, orphans the buffer storage and re-uploads all
+    /// slabs from their cpu copies
+    fn relayout(
+        &mut self,
+        bound_vao: &ScopedBind<Vao>,
+        bound_vbo: &ScopedBind<Vbo>,
+    ) -> GlResult<()> {
+        let mut offset = 0;
+        for range in self.ranges.iter_mut() {
+            range.offset = offset;
+            range.capacity = round_up_capacity(range.vertices.len());
+            offset += range.capacity;
+        }
+
+        if offset == 0 {
+            return Ok(());
+        }
+
+        bound_vao
+            .vertex_attribs()
+            .add(3, AttribType::Float32, Normalized::FixedPoint) // pos
+            .add(4, AttribType::UByte, Normalized::Normalized) // col
+            .build()?;
+
+        bound_vbo.buffer_data_uninitialized::<WorldVertex>(offset, BufferUsage::DynamicDraw)?;
+        for range in self.ranges.iter() {
+            bound_vbo.buffer_sub_data(range.offset, &range.vertices)?;
+        }
+
+        debug!(
+            "relayouted chunk mesh";
+            self.chunk_pos, "slabs" => self.ranges.len(), "vertices" => offset
+        );
+
+        Ok(())
+    }
+}
+
+fn round_up_capacity(vertices: usize) -> usize {
+    if vertices == 0 {
+        0
+    } else {
+        (vertices + SLAB_CAPACITY_QUANTUM - 1) / SLAB_CAPACITY_QUANTUM * SLAB_CAPACITY_QUANTUM
+    }
+}
@@ -130,7 +130,11 @@ fn do_main() -> BoxedResult<()> {
         let (simulation, initial_block) = preset.load(resources.clone(), scenario)?;
 
         // initialize backend with simulation world
-        let world_viewer = WorldViewer::with_world(simulation.voxel_world(), initial_block)?;
+        let world_viewer = WorldViewer::with_world(
+            simulation.voxel_world(),
+            initial_block,
+            simulation.world_worker_handle(),
+        )?;
         let backend = backend_state.start(world_viewer, initial_block);
 
         // create and run engine
@@ -23,7 +23,10 @@ pub use logging::{
     self, prelude::*, slog_kv_debug, slog_kv_display, slog_value_debug, slog_value_display,
 };
 #[cfg(feature = "metrics")]
-pub use metrics::{self, declare_entity_metric, entity_metric}; // nop macro declared below for disabled feature
+pub use metrics::{
+    self, declare_entity_metric, declare_gauge_metric, declare_histogram_metric, entity_metric,
+    gauge_metric, histogram_metric,
+}; // nop macros declared below for disabled feature
 pub use newtype::{NormalizedFloat, Proportion};
 
 // common imports that annoyingly get resolved to other pub exports of std/core
@@ -36,7 +39,8 @@ pub use std::{
     marker::PhantomData,
 };
 
-pub type BoxedResult<T> = Result<T, Box<dyn Error>>;
+// errors must be Send+Sync so they can live in ECS resources accessed by the parallel dispatcher
+pub type BoxedResult<T> = Result<T, Box<dyn Error + Send + Sync>>;
 
 pub type F = f32;
 pub type Vector3 = cgmath::Vector3<F>;
@@ -93,3 +97,15 @@ pub fn seeded_rng(seed: Option<u64>) -> StdRng {
 macro_rules! declare_entity_metric {
     ($($arg:tt)*) => {};
 }
+
+#[cfg(not(feature = "metrics"))]
+#[macro_export]
+macro_rules! declare_histogram_metric {
+    ($($arg:tt)*) => {};
+}
+
+#[cfg(not(feature = "metrics"))]
+#[macro_export]
+macro_rules! declare_gauge_metric {
+    ($($arg:tt)*) => {};
+}
@@ -29,6 +29,9 @@ pub struct World {
     pub initial_chunk: (i32, i32),
     pub initial_slab_depth: u32,
     pub initial_chunk_radius: u32,
+    /// Ring of neighbouring slabs to generate speculatively around each requested batch,
+    /// 0 to disable
+    pub slab_prefetch_radius: u32,
 }
 
 #[derive(Deserialize, Clone)]
@@ -1,4 +1,4 @@
-pub use load::{get, init, ConfigType};
+pub use load::{get, init, is_initialized, ConfigType};
 
 pub use self::config::*;
 
@@ -42,7 +42,8 @@ pub enum ConfigType<'a> {
 static mut CONFIG: MaybeUninit<ArcSwap<Config>> = MaybeUninit::uninit();
 static INITIALIZED: AtomicBool = AtomicBool::new(false);
 
-fn is_initialized() -> bool {
+/// Whether [init] has been called, i.e. [get] is safe to call
+pub fn is_initialized() -> bool {
     INITIALIZED.load(Relaxed)
 }
 
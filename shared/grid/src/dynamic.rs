@@ -4,6 +4,7 @@ use serde::{Deserialize, Serialize};
 
 use common::cgmath::num_traits::clamp;
 use common::{ArrayVec, Boolinator, Itertools};
+use rayon::prelude::*;
 
 // TODO use same CoordType for DynamicGrid
 #[derive(Serialize, Deserialize)]
@@ -37,6 +38,22 @@ impl<T: Default> DynamicGrid<T> {
         [index % xs, (index / xs) % ys, index / (ys * xs)]
     }
 
+    /// Flat-index deltas to same-z neighbours in the same order as [Self::neighbours],
+    /// only valid for cells not on an x/y boundary
+    pub fn neighbour_strides(&self) -> [isize; crate::NEIGHBOURS_COUNT] {
+        let xs = self.dims[0] as isize;
+
+        #[cfg(feature = "8neighbours")]
+        {
+            [-xs, 1 - xs, 1, 1 + xs, xs, xs - 1, -1, -1 - xs]
+        }
+
+        #[cfg(not(feature = "8neighbours"))]
+        {
+            [-xs, 1, xs, -1]
+        }
+    }
+
     #[inline]
     pub fn is_coord_in_range(&self, [x, y, z]: [usize; 3]) -> bool {
         x < self.dims[0] && y < self.dims[1] && z < self.dims[2]
@@ -170,39 +187,50 @@ impl<T: Default> DynamicGrid<T> {
         // profiling shows it's better to pass around an idx and unflatten than it is to pass
         // around [usize; 3]
         let coord = self.unflatten_index(index);
-
-        let x0 = Some(coord[0]);
-        let xp1 = Some(coord[0] + 1);
-        let xs1 = coord[0].checked_sub(1);
-
-        let y0 = Some(coord[1]);
-        let yp1 = Some(coord[1] + 1);
-        let ys1 = coord[1].checked_sub(1);
-
-        ArrayVec::from([
-            x0.zip(ys1),
-            #[cfg(feature = "8neighbours")]
-            xp1.zip(ys1),
-            xp1.zip(y0),
-            #[cfg(feature = "8neighbours")]
-            xp1.zip(yp1),
-            x0.zip(yp1),
-            #[cfg(feature = "8neighbours")]
-            xs1.zip(yp1),
-            xs1.zip(y0),
-            #[cfg(feature = "8neighbours")]
-            xs1.zip(ys1),
-        ])
-        .into_iter()
-        .flatten()
-        .filter_map(move |(x, y)| {
-            let coord = [x, y, 0];
-            if self.is_coord_in_range(coord) {
-                Some(self.flatten_coords(coord))
-            } else {
-                None
+        let [xs, ys, _] = self.dims;
+
+        let mut out = ArrayVec::<usize, 8>::new();
+        if (1..xs - 1).contains(&coord[0]) && (1..ys - 1).contains(&coord[1]) {
+            // interior cell, every neighbour is a constant stride away
+            let index = index as isize;
+            out.extend(
+                self.neighbour_strides()
+                    .iter()
+                    .map(|&delta| (index + delta) as usize),
+            );
+        } else {
+            let x0 = Some(coord[0]);
+            let xp1 = Some(coord[0] + 1);
+            let xs1 = coord[0].checked_sub(1);
+
+            let y0 = Some(coord[1]);
+            let yp1 = Some(coord[1] + 1);
+            let ys1 = coord[1].checked_sub(1);
+
+            let candidates = ArrayVec::from([
+                x0.zip(ys1),
+                #[cfg(feature = "8neighbours")]
+                xp1.zip(ys1),
+                xp1.zip(y0),
+                #[cfg(feature = "8neighbours")]
+                xp1.zip(yp1),
+                x0.zip(yp1),
+                #[cfg(feature = "8neighbours")]
+                xs1.zip(yp1),
+                xs1.zip(y0),
+                #[cfg(feature = "8neighbours")]
+                xs1.zip(ys1),
+            ]);
+
+            for (x, y) in candidates.into_iter().flatten() {
+                let coord = [x, y, coord[2]];
+                if self.is_coord_in_range(coord) {
+                    out.push(self.flatten_coords(coord));
+                }
             }
-        })
+        }
+
+        out.into_iter()
     }
 
     /// Wraps xy, clamps z
@@ -228,6 +256,13 @@ impl<T: Default> DynamicGrid<T> {
         coord: impl GridCoord<T>,
     ) -> impl ExactSizeIterator<Item = (usize, [isize; 2])> + Clone + '_ {
         let [x, y, z] = coord.into_coord(self);
+
+        // interior cells skip wrapping entirely and step by precomputed strides
+        let [xs, ys, _] = self.dims;
+        let interior = (1..xs - 1).contains(&x) && (1..ys - 1).contains(&y);
+        let base = (x + xs * y) as isize;
+        let strides = self.neighbour_strides();
+
         let coord = [x as isize, y as isize, z as isize];
 
         let x0 = coord[0];
@@ -253,12 +288,82 @@ impl<T: Default> DynamicGrid<T> {
             (xs1, ys1),
         ])
         .into_iter()
-        .map(move |(x, y)| {
-            let coord = [x, y, 0];
-            let coord = self.wrap_coord(coord);
-            (self.flatten_coords(coord), [x, y])
+        .enumerate()
+        .map(move |(i, (x, y))| {
+            let idx = if interior {
+                (base + strides[i]) as usize
+            } else {
+                let coord = self.wrap_coord([x, y, 0]);
+                self.flatten_coords(coord)
+            };
+            (idx, [x, y])
         })
     }
+
+    /// Applies `f` to every cell in parallel, splitting the grid into contiguous bands of
+    /// whole rows so each worker streams through its own slice of memory. `f` must only
+    /// write to its own cell - if it reads neighbours too, double buffer the grid
+    pub fn par_map_in_place(&mut self, f: impl Fn([usize; 3], &mut T) + Sync)
+    where
+        T: Send,
+    {
+        let dims = self.dims;
+        let row_len = dims[0];
+        let total_rows = dims[1] * dims[2];
+        let rows_per_band = (total_rows / rayon::current_num_threads()).max(1);
+        let band_len = rows_per_band * row_len;
+
+        self.data
+            .par_chunks_mut(band_len)
+            .enumerate()
+            .for_each(|(band, chunk)| {
+                let coords = CoordIter::from_index(band * band_len, dims);
+                for (coord, value) in coords.zip(chunk.iter_mut()) {
+                    f(coord, value);
+                }
+            });
+    }
+}
+
+/// Yields coordinates in flat index order with a single unflatten up front, then pure
+/// increments instead of a div/mod per cell
+#[derive(Clone)]
+pub struct CoordIter {
+    dims: [usize; 3],
+    coord: [usize; 3],
+}
+
+impl CoordIter {
+    pub fn from_index(index: usize, dims: [usize; 3]) -> Self {
+        let [xs, ys, _] = dims;
+        let coord = [index % xs, (index / xs) % ys, index / (xs * ys)];
+        Self { dims, coord }
+    }
+}
+
+impl Iterator for CoordIter {
+    type Item = [usize; 3];
+
+    fn next(&mut self) -> Option<Self::Item> {
+        if self.coord[2] >= self.dims[2] {
+            return None;
+        }
+
+        let current = self.coord;
+
+        let [x, y, z] = &mut self.coord;
+        *x += 1;
+        if *x == self.dims[0] {
+            *x = 0;
+            *y += 1;
+            if *y == self.dims[1] {
+                *y = 0;
+                *z += 1;
+            }
+        }
+
+        Some(current)
+    }
 }
 
 impl<T> Index<usize> for DynamicGrid<T> {
@@ -414,6 +519,37 @@ mod tests {
         }
     }
 
+    #[test]
+    fn dynamic_grid_coord_iter() {
+        let grid = DynamicGrid::<()>::new([5, 4, 3]);
+
+        for start in [0usize, 7, 19].iter().copied() {
+            let expected = (start..grid.len())
+                .map(|i| grid.unflatten_index(i))
+                .collect::<Vec<_>>();
+            let actual = CoordIter::from_index(start, grid.dimensions()).collect::<Vec<_>>();
+            assert_eq!(expected, actual);
+        }
+    }
+
+    #[test]
+    fn dynamic_grid_neighbours_interior() {
+        let grid = DynamicGrid::<()>::new([5, 4, 1]);
+
+        // interior cell takes the stride fast path
+        let interior = grid.neighbours(12).collect::<Vec<_>>();
+        assert_eq!(interior.len(), crate::NEIGHBOURS_COUNT);
+        for n in [7, 13, 17, 11].iter() {
+            assert!(interior.contains(n));
+        }
+
+        // corner falls back to bounds checks
+        let corner = grid.neighbours(4).collect::<Vec<_>>();
+        assert!(corner.contains(&3));
+        assert!(corner.contains(&9));
+        assert!(!corner.contains(&5));
+    }
+
     #[test]
     fn dynamic_grid_non_serializable_type() {
         struct A(*const i32);
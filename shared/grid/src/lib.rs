@@ -1,3 +1,4 @@
+pub use dynamic::CoordIter;
 pub use dynamic::CoordRange;
 pub use dynamic::DynamicGrid;
 pub use grid_impl::{CoordType, Grid, GridImpl};
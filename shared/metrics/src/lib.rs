@@ -32,6 +32,52 @@ macro_rules! entity_metric {
     };
 }
 
+#[macro_export]
+macro_rules! declare_histogram_metric {
+    ($name:ident, $metric:expr, $help:expr) => {
+        lazy_static! {
+            static ref $name: $crate::prometheus::Histogram =
+                $crate::prometheus::register_histogram!($metric, $help)
+                    .expect("metric registration failed");
+        }
+    };
+    ($name:ident, $metric:expr, $help:expr, $($labels:expr),+) => {
+        lazy_static! {
+            static ref $name: $crate::prometheus::HistogramVec =
+                $crate::prometheus::register_histogram_vec!($metric, $help, &[$($labels),+])
+                    .expect("metric registration failed");
+        }
+    }
+}
+
+#[macro_export]
+macro_rules! histogram_metric {
+    ($name:ident, $value:expr) => {
+        $name.observe($value as f64);
+    };
+    ($name:ident, $value:expr, $($labels:expr),+) => {
+        $name.with_label_values(&[$($labels),+]).observe($value as f64);
+    };
+}
+
+#[macro_export]
+macro_rules! declare_gauge_metric {
+    ($name:ident, $metric:expr, $help:expr) => {
+        lazy_static! {
+            static ref $name: $crate::prometheus::Gauge =
+                $crate::prometheus::register_gauge!($metric, $help)
+                    .expect("metric registration failed");
+        }
+    };
+}
+
+#[macro_export]
+macro_rules! gauge_metric {
+    ($name:ident, $value:expr) => {
+        $name.set($value as f64);
+    };
+}
+
 // TODO return error to caller
 pub fn start_serving() {
     std::thread::spawn(|| {